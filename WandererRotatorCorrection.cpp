@@ -0,0 +1,171 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorCorrection.h"
+#include "WandererRotatorProtocol.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+namespace WandererRotator
+{
+	/* Fixed-point iterations inverting the table, errors are small and smooth */
+	static constexpr int INVERSE_ITERATIONS = 4;
+
+	static int NormalizeMilliDegrees(long long milliDegrees)
+	{
+		return (int)(((milliDegrees % MILLIDEGREES_PER_REVOLUTION) + MILLIDEGREES_PER_REVOLUTION) % MILLIDEGREES_PER_REVOLUTION);
+	}
+
+	bool CorrectionTable::Build(const float *angles, const float *errors, int count)
+	{
+		if (!angles || !errors || count < 1 || count > MAX_POINTS)
+		{
+			return false;
+		}
+
+		std::vector<int> order(count);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](int a, int b) { return angles[a] < angles[b]; });
+
+		std::vector<int> sortedAngles;
+		std::vector<double> sortedErrors;
+		for (int i : order)
+		{
+			if (!(angles[i] >= 0.0f && angles[i] < 360.0f) || !(fabsf(errors[i]) <= MAX_ERROR_DEGREES))
+			{
+				return false;
+			}
+
+			int milliDegrees = (int)lround(angles[i] * 1000.0) % MILLIDEGREES_PER_REVOLUTION;
+			if (!sortedAngles.empty() && milliDegrees <= sortedAngles.back())
+			{
+				return false;
+			}
+
+			sortedAngles.push_back(milliDegrees);
+			sortedErrors.push_back(errors[i] * 1000.0);
+		}
+
+		this->angles.swap(sortedAngles);
+		this->errors.swap(sortedErrors);
+		return true;
+	}
+
+	double CorrectionTable::ErrorAt(int mechanicalMilliDegrees) const
+	{
+		int n = Count();
+		if (n == 0)
+		{
+			return 0.0;
+		}
+		if (n == 1)
+		{
+			return errors[0];
+		}
+
+		int m = NormalizeMilliDegrees(mechanicalMilliDegrees);
+
+		/* First point above m; the segment before it may wrap around 360 */
+		int upper = (int)(std::upper_bound(angles.begin(), angles.end(), m) - angles.begin());
+		int lower = upper - 1;
+
+		long long lowerAngle, upperAngle;
+		if (upper == n)
+		{
+			upper = 0;
+			lowerAngle = angles[lower];
+			upperAngle = angles[0] + MILLIDEGREES_PER_REVOLUTION;
+		}
+		else if (lower < 0)
+		{
+			lower = n - 1;
+			lowerAngle = angles[lower] - MILLIDEGREES_PER_REVOLUTION;
+			upperAngle = angles[upper];
+		}
+		else
+		{
+			lowerAngle = angles[lower];
+			upperAngle = angles[upper];
+		}
+
+		double fraction = (double)(m - lowerAngle) / (double)(upperAngle - lowerAngle);
+		return errors[lower] + fraction * (errors[upper] - errors[lower]);
+	}
+
+	int CorrectionTable::ToTrue(int mechanicalMilliDegrees) const
+	{
+		return NormalizeMilliDegrees(mechanicalMilliDegrees + llround(ErrorAt(mechanicalMilliDegrees)));
+	}
+
+	int CorrectionTable::ToMechanical(int trueMilliDegrees) const
+	{
+		/* Solve m + error(m) = true */
+		long long m = trueMilliDegrees;
+		for (int i = 0; i < INVERSE_ITERATIONS; i++)
+		{
+			m = trueMilliDegrees - llround(ErrorAt((int)NormalizeMilliDegrees(m)));
+		}
+		return NormalizeMilliDegrees(m);
+	}
+
+	bool ReadCorrectionFile(const char *path, std::vector<float> &angles, std::vector<float> &errors)
+	{
+		FILE *file = fopen(path, "r");
+		if (!file)
+		{
+			return false;
+		}
+
+		bool ok = true;
+		char line[256];
+		while (ok && fgets(line, sizeof(line), file))
+		{
+			const char *p = line + strspn(line, " \t");
+			if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0')
+			{
+				continue;
+			}
+
+			float angle, error;
+			char trailing;
+			int fields = sscanf(p, "%f %f %c", &angle, &error, &trailing);
+			if (fields == 2 || (fields == 3 && trailing == '#'))
+			{
+				angles.push_back(angle);
+				errors.push_back(error);
+			}
+			else
+			{
+				ok = false;
+			}
+		}
+
+		fclose(file);
+		return ok;
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,94 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_CORRECTION_H
+#define WANDERER_ROTATOR_CORRECTION_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - ERROR CORRECTION TABLE
+ *
+ * Repeatable positional error versus mechanical angle, from calibration.
+ * The error at a mechanical angle is true angle minus reported angle and is
+ * interpolated linearly between points, wrapping around at 360 degrees.
+ * Tables are immutable once built and swapped atomically on the device, so
+ * the move listener can read them without any lock.
+ * ============================================================================ */
+
+#include <string>
+#include <vector>
+
+namespace WandererRotator
+{
+	class CorrectionTable
+	{
+	public:
+		/* Calibration points per table */
+		static constexpr int MAX_POINTS = 3600;
+
+		/* Largest error accepted at a point, in degrees */
+		static constexpr float MAX_ERROR_DEGREES = 10.0f;
+
+		/**
+		 * Build from calibration points in any order.
+		 *
+		 * @param angles Mechanical angles in degrees, [0, 360), distinct
+		 * @param errors True minus reported angle at each point, in degrees
+		 * @param count Number of points, 1 to MAX_POINTS
+		 * @return false if the points are invalid
+		 */
+		bool Build(const float *angles, const float *errors, int count);
+
+		/**
+		 * Interpolated error at a mechanical angle, in millidegrees.
+		 */
+		double ErrorAt(int mechanicalMilliDegrees) const;
+
+		/**
+		 * True angle for a mechanical angle, both in millidegrees [0, 360000).
+		 */
+		int ToTrue(int mechanicalMilliDegrees) const;
+
+		/**
+		 * Mechanical angle that lands on a true angle, both in millidegrees [0, 360000).
+		 */
+		int ToMechanical(int trueMilliDegrees) const;
+
+		int Count() const { return (int)angles.size(); }
+
+	private:
+		std::vector<int> angles;	/* Millidegrees, ascending */
+		std::vector<double> errors; /* Millidegrees */
+	};
+
+	/**
+	 * Read calibration points from a text file with one "angle error" pair
+	 * (degrees) per line. Blank lines and lines starting with '#' are skipped.
+	 *
+	 * @return false if the file cannot be read or a line is malformed
+	 */
+	bool ReadCorrectionFile(const char *path, std::vector<float> &angles, std::vector<float> &errors);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_CORRECTION_H */
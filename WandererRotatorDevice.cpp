@@ -26,7 +26,42 @@
 
 namespace WandererRotator
 {
-    std::map<int, std::shared_ptr<Device>> g_devices;
-    std::mutex g_globalMutex;
+    std::mutex g_registryMutex;
+
+    const std::shared_ptr<Device> &DeviceTable::Find(int id) const
+    {
+        static const std::shared_ptr<Device> none;
+        return (id >= 0 && id < (int)slots.size()) ? slots[id] : none;
+    }
+
+    void DeviceTable::Set(int id, std::shared_ptr<Device> device)
+    {
+        if (id >= (int)slots.size())
+        {
+            slots.resize(id + 1);
+        }
+
+        count += (device != nullptr) - (slots[id] != nullptr);
+        slots[id] = std::move(device);
+    }
+
+    /* Swapped with std::atomic_store, read with std::atomic_load */
+    static std::shared_ptr<const DeviceTable> g_registry = std::make_shared<const DeviceTable>();
+
+    std::shared_ptr<const DeviceTable> SnapshotDevices()
+    {
+        return std::atomic_load(&g_registry);
+    }
+
+    std::shared_ptr<Device> FindDevice(int id)
+    {
+        std::shared_ptr<const DeviceTable> devices = SnapshotDevices();
+        return devices->Find(id);
+    }
+
+    void PublishDevices(std::shared_ptr<const DeviceTable> devices)
+    {
+        std::atomic_store(&g_registry, devices);
+    }
 
 } /* namespace WandererRotator */
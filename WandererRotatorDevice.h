@@ -25,26 +25,50 @@
 #ifndef WANDERER_ROTATOR_DEVICE_H
 #define WANDERER_ROTATOR_DEVICE_H
 
+#include "WandererRotatorSDK.h"
 #include "WandererRotatorSerialPort.h"
+#include "WandererRotatorStats.h"
+#include "WandererRotatorSkyModel.h"
+#include "WandererRotatorCorrection.h"
+#include "WandererRotatorHistory.h"
+#include "WandererRotatorTrace.h"
 #include <memory>
 #include <string>
-#include <map>
+#include <vector>
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
 
 namespace WandererRotator
 {
+	/**
+	 * Move listener thread of a device, started once and reused by every
+	 * move. Shared with the thread, which only holds a weak reference to
+	 * the device, so it outlives the device.
+	 */
+	struct MoveListener
+	{
+		std::mutex mutex;
+		std::condition_variable wake;
+		bool armed = false; /* A move phase awaits its feedback */
+		bool exit = false;	/* The device is gone */
+	};
+
 	/**
 	 * Device represents a Wanderer Rotator device with its current state.
 	 */
 	struct Device
 	{
+		int id = -1;
 		std::shared_ptr<SerialPort> port;
 		std::string portName;
+		SerialProfile serialProfile; /* Applied on every open of the port */
 		std::string modelType;
+		const WR_MODEL_TRAITS *traits = nullptr; /* Resolved from modelType, see FindModel() */
 		int firmwareVersion = 0;
-		int mechanicalAngle = 0;
+		int mechanicalAngle = 0;	 /* Millidegrees, as reported by the device */
+		bool positionValid = false;	 /* mechanicalAngle was read back and nothing has moved since */
 		int backlash = 0;
 		int reverseDirection = 0;
 		int stepsPerDegree = 0;
@@ -53,7 +77,17 @@ namespace WandererRotator
 		float overshootAngle = 0.0f; /* Backlash overshoot angle in degrees */
 		int overshotDirection = 0;	 /* 0 - normal, 1 - reverse */
 		int overshooting = 0;		 /* 0 - not in overshoot, 1 - in first phase, 2 - awaiting return */
-		float targetAngle = 0.0f;	 /* Target angle for second phase of overshoot */
+		int overshootReturnSteps = 0; /* Signed steps of the second phase of overshoot */
+		int commandGapMs = 100;		 /* Pause before each command and handshake */
+		int queryGapMs = 100;		 /* Pause before each status query, tuned by WRRotatorLinkTest() */
+		int responseTimeoutMs = 3000; /* Timeout per response field, tuned by WRRotatorLinkTest() */
+		int requestedSteps = 0;		 /* Net signed steps of the current move, all phases */
+		int moveSteps = 0;			 /* Signed step count of the move phase in flight */
+		float deadband = 0.0f;		 /* Moves smaller than this (degrees) are suppressed */
+		std::string profileName;	 /* Last profile applied, empty if none */
+		float targets[WR_TARGET_QUEUE_LEN] = {}; /* Upcoming targets, see WRRotatorQueueTarget() */
+		int targetCount = 0;
+		std::shared_ptr<const CorrectionTable> correction; /* Access with std::atomic_load/store, nullptr = none */
 
 		struct RotatorConfig
 		{
@@ -69,23 +103,122 @@ namespace WandererRotator
 			float stepSize = 0.0f;
 		} status;
 
+		DeviceStats stats;
+		SkyModel sky; /* Mechanical to sky angle relation, learned by WRRotatorSolveTo() */
+
+		/* Application event callback */
+		std::mutex eventMutex;
+		WR_EVENT_CALLBACK eventCallback = nullptr;
+		void *eventContext = nullptr;
+
+		/* Recent events, read by WRRotatorGetHistory() without locking */
+		EventHistory history;
+
+		/* Subscriptions to state changes, see WandererRotatorNotify.h */
+		std::atomic<int> subscribers{0};
+
+		/* Serializes API calls on this device */
+		std::mutex apiMutex;
+
+		/* Serializes WRRotatorSolveTo(), which releases apiMutex while it measures */
+		std::mutex solveMutex;
+
 		/* Listener thread state - don't store thread, just the flag */
 		std::atomic<bool> listenerRunning{false};
-		std::mutex listenerMutex;
+		std::shared_ptr<MoveListener> listener; /* Created by the first open */
+
+		/* Let the listener thread leave */
+		~Device()
+		{
+			if (listener)
+			{
+				std::lock_guard<std::mutex> lock(listener->mutex);
+				listener->exit = true;
+				listener->wake.notify_all();
+			}
+		}
+	};
+
+	/**
+	 * Scoped lock on a device's API mutex that records how long the caller
+	 * waited. Taken by every API call and by the background threads that
+	 * touch the same fields.
+	 */
+	class DeviceLock
+	{
+	private:
+		std::unique_lock<std::mutex> lock;
+
+	public:
+		DeviceLock(const std::shared_ptr<Device> &device, const char *site) : lock(device->apiMutex, std::defer_lock)
+		{
+			if (!TraceEnabled())
+			{
+				lock.lock();
+				return;
+			}
+
+			long long start = TraceNowUs();
+			lock.lock();
+			TraceWrite(device->portName.c_str(), WR_TRACE_LOCK, "site=%s us=%lld", site, TraceNowUs() - start);
+		}
+
+		/** Release early, e.g. before calling back into the application */
+		void Unlock() { lock.unlock(); }
 
-		/* Simple destructor - nothing to clean up */
-		~Device() = default;
+		/** Take the lock again after Unlock() */
+		void Relock() { lock.lock(); }
 	};
 
 	/**
-	 * Global device registry mapping device IDs to Device objects.
+	 * One generation of the device registry. Devices sit in one array
+	 * indexed by ID, so lookups are O(1) and IDs are kept dense. Grows
+	 * without limit; immutable once published.
+	 */
+	class DeviceTable
+	{
+	public:
+		/** Device with this ID, nullptr if none */
+		const std::shared_ptr<Device> &Find(int id) const;
+
+		/** Add or replace the device at its ID */
+		void Set(int id, std::shared_ptr<Device> device);
+
+		bool Contains(int id) const { return Find(id) != nullptr; }
+
+		/** Number of devices */
+		int Count() const { return count; }
+
+		/** Devices indexed by ID; unused IDs hold nullptr */
+		const std::vector<std::shared_ptr<Device>> &Slots() const { return slots; }
+
+	private:
+		std::vector<std::shared_ptr<Device>> slots;
+		int count = 0;
+	};
+
+	/**
+	 * Current registry generation. Never blocks; the snapshot and its
+	 * devices stay valid for as long as the caller holds it.
+	 */
+	std::shared_ptr<const DeviceTable> SnapshotDevices();
+
+	/**
+	 * Look up a device in the current registry generation.
+	 *
+	 * @return Device, or nullptr if the ID is unknown
+	 */
+	std::shared_ptr<Device> FindDevice(int id);
+
+	/**
+	 * Replace the current registry generation. Callers hold g_registryMutex.
 	 */
-	extern std::map<int, std::shared_ptr<Device>> g_devices;
+	void PublishDevices(std::shared_ptr<const DeviceTable> devices);
 
 	/**
-	 * Global mutex protecting access to g_devices.
+	 * Serializes registry writers (scans). Readers never take it.
 	 */
-	extern std::mutex g_globalMutex;
+	extern std::mutex g_registryMutex;
 
 } /* namespace WandererRotator */
 
@@ -0,0 +1,79 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorEvents.h"
+#include "WandererRotatorTrace.h"
+#include <cstring>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * EVENT DELIVERY
+	 * ============================================================================ */
+
+	WR_EVENT MakeEvent(const std::shared_ptr<Device> &device, WR_EVENT_TYPE type)
+	{
+		WR_EVENT event;
+		memset(&event, 0, sizeof(event));
+		event.id = device->id;
+		event.type = type;
+		event.timestampUs = TraceNowUs();
+		event.position = device->status.position;
+		return event;
+	}
+
+	void EmitEvent(const std::shared_ptr<Device> &device, const WR_EVENT &event)
+	{
+		WR_EVENT_CALLBACK callback;
+		void *context;
+		{
+			std::lock_guard<std::mutex> lock(device->eventMutex);
+			callback = device->eventCallback;
+			context = device->eventContext;
+		}
+
+		if (callback)
+		{
+			callback(&event, context);
+		}
+	}
+
+	WR_HISTORY_ENTRY MakeHistoryEntry(const std::shared_ptr<Device> &device, WR_HISTORY_TYPE type)
+	{
+		WR_HISTORY_ENTRY entry;
+		memset(&entry, 0, sizeof(entry));
+		entry.type = type;
+		entry.timestampUs = TraceNowUs();
+		entry.position = device->status.position;
+		return entry;
+	}
+
+	void SetEventCallback(const std::shared_ptr<Device> &device, WR_EVENT_CALLBACK callback, void *context)
+	{
+		std::lock_guard<std::mutex> lock(device->eventMutex);
+		device->eventCallback = callback;
+		device->eventContext = context;
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,65 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_EVENTS_H
+#define WANDERER_ROTATOR_EVENTS_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - EVENTS MODULE
+ *
+ * Delivery of structured device events to the application callback, and
+ * the entries of the per-device event history.
+ * ============================================================================ */
+
+#include "WandererRotatorDevice.h"
+
+namespace WandererRotator
+{
+	/**
+	 * Create an event of the given type for a device, stamped with the
+	 * current monotonic time and cached position.
+	 */
+	WR_EVENT MakeEvent(const std::shared_ptr<Device> &device, WR_EVENT_TYPE type);
+
+	/**
+	 * Deliver an event to the device's callback, if one is set.
+	 * Must not be called with the device lock held, callbacks may call the SDK.
+	 */
+	void EmitEvent(const std::shared_ptr<Device> &device, const WR_EVENT &event);
+
+	/**
+	 * Create a history entry of the given type for a device, stamped with
+	 * the current monotonic time and cached position. Record it with
+	 * device->history.Record().
+	 */
+	WR_HISTORY_ENTRY MakeHistoryEntry(const std::shared_ptr<Device> &device, WR_HISTORY_TYPE type);
+
+	/**
+	 * Install or clear the event callback of a device.
+	 */
+	void SetEventCallback(const std::shared_ptr<Device> &device, WR_EVENT_CALLBACK callback, void *context);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_EVENTS_H */
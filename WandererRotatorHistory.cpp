@@ -0,0 +1,88 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorHistory.h"
+#include <cstring>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * EVENT HISTORY RING
+	 * ============================================================================ */
+
+	void EventHistory::Record(const WR_HISTORY_ENTRY &entry)
+	{
+		unsigned long long sequence = next.fetch_add(1, std::memory_order_relaxed);
+		Slot &slot = slots[sequence % WR_HISTORY_LEN];
+
+		WR_HISTORY_ENTRY stamped = entry;
+		stamped.sequence = sequence;
+		unsigned long long words[WORDS] = {0};
+		memcpy(words, &stamped, sizeof(stamped));
+
+		slot.state.store(2 * sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		for (int i = 0; i < WORDS; i++)
+		{
+			slot.words[i].store(words[i], std::memory_order_relaxed);
+		}
+		slot.state.store(2 * sequence + 2, std::memory_order_release);
+	}
+
+	int EventHistory::Read(WR_HISTORY_ENTRY *entries, int capacity) const
+	{
+		unsigned long long end = next.load(std::memory_order_acquire);
+		unsigned long long available = end < WR_HISTORY_LEN ? end : WR_HISTORY_LEN;
+		unsigned long long wanted = (unsigned long long)capacity < available ? capacity : available;
+
+		int count = 0;
+		for (unsigned long long sequence = end - wanted; sequence < end; sequence++)
+		{
+			const Slot &slot = slots[sequence % WR_HISTORY_LEN];
+
+			/* Skip slots still being written or already reused */
+			unsigned long long state = slot.state.load(std::memory_order_acquire);
+			if (state != 2 * sequence + 2)
+			{
+				continue;
+			}
+
+			unsigned long long words[WORDS];
+			for (int i = 0; i < WORDS; i++)
+			{
+				words[i] = slot.words[i].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.state.load(std::memory_order_relaxed) != state)
+			{
+				continue;
+			}
+
+			memcpy(&entries[count++], words, sizeof(WR_HISTORY_ENTRY));
+		}
+
+		return count;
+	}
+
+} /* namespace WandererRotator */
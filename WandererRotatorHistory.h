@@ -0,0 +1,78 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_HISTORY_H
+#define WANDERER_ROTATOR_HISTORY_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - HISTORY MODULE
+ *
+ * Bounded ring of the most recent structured events of a device. Writers
+ * claim slots with an atomic counter and readers validate each slot with
+ * its sequence number, so neither side ever takes a lock or allocates.
+ * ============================================================================ */
+
+#include "WandererRotatorSDK.h"
+#include <atomic>
+
+namespace WandererRotator
+{
+	/**
+	 * Last WR_HISTORY_LEN events of a device.
+	 */
+	class EventHistory
+	{
+	public:
+		/**
+		 * Append an entry, overwriting the oldest. Its sequence number is
+		 * assigned here. Safe from any thread.
+		 */
+		void Record(const WR_HISTORY_ENTRY &entry);
+
+		/**
+		 * Copy the most recent entries, oldest first. Entries overwritten
+		 * during the copy are left out.
+		 *
+		 * @param entries Output array
+		 * @param capacity Entries the array holds
+		 * @return Number of entries copied
+		 */
+		int Read(WR_HISTORY_ENTRY *entries, int capacity) const;
+
+	private:
+		static constexpr int WORDS = (sizeof(WR_HISTORY_ENTRY) + 7) / 8;
+
+		struct Slot
+		{
+			std::atomic<unsigned long long> state{0}; /* 2 * sequence + 2 when complete, odd while written */
+			std::atomic<unsigned long long> words[WORDS];
+		};
+
+		std::atomic<unsigned long long> next{0}; /* Sequence number of the next entry */
+		Slot slots[WR_HISTORY_LEN];
+	};
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_HISTORY_H */
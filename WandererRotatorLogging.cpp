@@ -76,6 +76,23 @@ namespace WandererRotator
 		va_end(args);
 	}
 
+	void WRLogWarn(const char *fmt, ...)
+	{
+		va_list args;
+		va_start(args, fmt);
+		if (WandererRotator::WR_TIMESTAMP_ENABLED)
+		{
+			fprintf(stderr, "[%s] [WR_WARN] ", WRGetTimestamp());
+		}
+		else
+		{
+			fprintf(stderr, "[WR_WARN] ");
+		}
+		vfprintf(stderr, fmt, args);
+		fprintf(stderr, "\n");
+		va_end(args);
+	}
+
 	void WRLogError(const char *fmt, ...)
 	{
 		va_list args;
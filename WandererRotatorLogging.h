@@ -37,6 +37,7 @@ namespace WandererRotator
 	/* Compile-time logging configuration */
 	static constexpr bool WR_DEBUG_ENABLED = false; /* Disable debug logging by default */
 	static constexpr bool WR_INFO_ENABLED = false;	/* Enable info logging */
+	static constexpr bool WR_WARN_ENABLED = true;	/* Enable warning logging (timeouts, malformed responses) */
 	static constexpr bool WR_ERROR_ENABLED = true;	/* Enable error logging */
 	static constexpr bool WR_TIMESTAMP_ENABLED = true; /* Enable timestamps in logs */
 
@@ -59,6 +60,15 @@ namespace WandererRotator
 		}                                                   \
 	} while (0)
 
+#define WR_WARN(fmt, ...)                                   \
+	do                                                      \
+	{                                                       \
+		if (WandererRotator::WR_WARN_ENABLED)               \
+		{                                                   \
+			WandererRotator::WRLogWarn(fmt, ##__VA_ARGS__); \
+		}                                                   \
+	} while (0)
+
 #define WR_ERROR(fmt, ...)                                   \
 	do                                                       \
 	{                                                        \
@@ -71,6 +81,7 @@ namespace WandererRotator
 	/* Logging functions - called by macros */
 	void WRLogDebug(const char *fmt, ...);
 	void WRLogInfo(const char *fmt, ...);
+	void WRLogWarn(const char *fmt, ...);
 	void WRLogError(const char *fmt, ...);
 	const char *WRGetTimestamp();
 
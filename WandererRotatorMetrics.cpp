@@ -0,0 +1,467 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorMetrics.h"
+#include "WandererRotatorDevice.h"
+#include "WandererRotatorLogging.h"
+#include "WandererRotatorProtocol.h"
+#include "WandererRotatorThreads.h"
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * OPENMETRICS FORMATTING
+	 * ============================================================================ */
+
+	static void Append(std::string &out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+	static void Append(std::string &out, const char *fmt, ...)
+	{
+		char line[512];
+		va_list args;
+		va_start(args, fmt);
+		int n = vsnprintf(line, sizeof(line), fmt, args);
+		va_end(args);
+		if (n > 0)
+		{
+			out.append(line, n < (int)sizeof(line) ? n : (int)sizeof(line) - 1);
+		}
+	}
+
+	/* Escape a label value as required by the exposition format */
+	static std::string EscapeLabel(const std::string &value)
+	{
+		std::string escaped;
+		for (char c : value)
+		{
+			if (c == '\\' || c == '"')
+			{
+				escaped += '\\';
+				escaped += c;
+			}
+			else if (c == '\n')
+			{
+				escaped += "\\n";
+			}
+			else
+			{
+				escaped += c;
+			}
+		}
+		return escaped;
+	}
+
+	/* One device's labels and movement state, copied under its lock */
+	struct MetricSample
+	{
+		std::string labels; /* id="0",port="...",model="..." */
+		std::shared_ptr<Device> device;
+		double position = 0.0;
+		bool moving = false;
+		int phase = 0;
+		double etaS = 0.0;
+	};
+
+	static void AppendCounter(std::string &out, const std::vector<MetricSample> &samples, const char *name,
+							  const char *help, unsigned int (*value)(const Device &))
+	{
+		Append(out, "# TYPE %s counter\n# HELP %s %s\n", name, name, help);
+		for (const auto &sample : samples)
+		{
+			Append(out, "%s_total{%s} %u\n", name, sample.labels.c_str(), value(*sample.device));
+		}
+	}
+
+	static void AppendGauge(std::string &out, const std::vector<MetricSample> &samples, const char *name,
+							const char *help, double (*value)(const MetricSample &))
+	{
+		Append(out, "# TYPE %s gauge\n# HELP %s %s\n", name, name, help);
+		for (const auto &sample : samples)
+		{
+			Append(out, "%s{%s} %.6g\n", name, sample.labels.c_str(), value(sample));
+		}
+	}
+
+	std::string FormatMetrics()
+	{
+		std::vector<MetricSample> samples;
+		{
+			std::shared_ptr<const DeviceTable> devices = SnapshotDevices();
+			for (const auto &device : devices->Slots())
+			{
+				if (!device)
+				{
+					continue;
+				}
+
+				/* Copy the state that API calls and the listener update under the lock */
+				DeviceLock lock(device, __func__);
+				if (!device->port || !device->port->IsOpen())
+				{
+					continue;
+				}
+
+				MetricSample sample;
+				sample.labels = "id=\"" + std::to_string(device->id) + "\",port=\"" + EscapeLabel(device->portName) +
+								"\",model=\"" + EscapeLabel(device->modelType) + "\"";
+				sample.device = device;
+				sample.position = device->status.position;
+				sample.moving = device->status.moving != 0;
+				sample.phase = sample.moving ? device->overshooting : 0;
+				sample.etaS = RemainingMoveMs(*device) / 1000.0;
+				samples.push_back(sample);
+			}
+		}
+
+		std::string out;
+		out.reserve(1024 + samples.size() * 2048);
+
+		AppendCounter(out, samples, "wr_rotator_commands", "Commands and queries written.",
+					  [](const Device &d) -> unsigned int { return d.stats.commands; });
+		AppendCounter(out, samples, "wr_rotator_moves", "Move phases submitted.",
+					  [](const Device &d) -> unsigned int { return d.stats.moves; });
+		AppendCounter(out, samples, "wr_rotator_timeouts", "Response fields that never arrived.",
+					  [](const Device &d) -> unsigned int { return d.stats.timeouts; });
+		AppendCounter(out, samples, "wr_rotator_parse_errors", "Response fields that could not be parsed.",
+					  [](const Device &d) -> unsigned int { return d.stats.parseErrors; });
+		AppendCounter(out, samples, "wr_rotator_reconnects", "Opens after the first one.",
+					  [](const Device &d) -> unsigned int { return d.stats.reconnects; });
+
+		AppendGauge(out, samples, "wr_rotator_position_degrees", "Cached rotator position.",
+					[](const MetricSample &s) -> double { return s.position; });
+		AppendGauge(out, samples, "wr_rotator_moving", "1 while a move is in progress.",
+					[](const MetricSample &s) -> double { return s.moving ? 1.0 : 0.0; });
+		AppendGauge(out, samples, "wr_rotator_move_phase", "0 plain move or idle, 1 overshoot out, 2 overshoot return.",
+					[](const MetricSample &s) -> double { return s.phase; });
+		AppendGauge(out, samples, "wr_rotator_move_eta_seconds", "Predicted time until the move in flight has finished.",
+					[](const MetricSample &s) -> double { return s.etaS; });
+		AppendGauge(out, samples, "wr_rotator_last_move_error", "Error code of the most recent move, 0 on success.",
+					[](const MetricSample &s) -> double { return s.device->stats.lastMoveError; });
+		AppendGauge(out, samples, "wr_rotator_step_rate", "Effective step rate learned from completed moves in steps per second.",
+					[](const MetricSample &s) -> double { return s.device->stats.moveModel.StepRate(); });
+
+		const char *histogram = "wr_rotator_query_latency_seconds";
+		Append(out, "# TYPE %s histogram\n# HELP %s Query round-trip time.\n", histogram, histogram);
+		for (const auto &sample : samples)
+		{
+			const LatencyHistogram &latency = sample.device->stats.latency;
+			unsigned long long cumulative = 0;
+			for (int i = 0; i < LatencyHistogram::BUCKETS; i++)
+			{
+				cumulative += latency.BucketCount(i);
+				if (i < LatencyHistogram::BUCKETS - 1)
+				{
+					Append(out, "%s_bucket{%s,le=\"%g\"} %llu\n", histogram, sample.labels.c_str(),
+						   LatencyHistogram::BOUNDS_MS[i] / 1000.0, cumulative);
+				}
+				else
+				{
+					Append(out, "%s_bucket{%s,le=\"+Inf\"} %llu\n", histogram, sample.labels.c_str(), cumulative);
+				}
+			}
+			/* Count matches the +Inf bucket even if a record lands between the reads above */
+			Append(out, "%s_count{%s} %llu\n", histogram, sample.labels.c_str(), cumulative);
+			Append(out, "%s_sum{%s} %.6f\n", histogram, sample.labels.c_str(), latency.SumMs() / 1000.0);
+		}
+
+		out += "# EOF\n";
+		return out;
+	}
+
+	/* ============================================================================
+	 * HTTP SERVER
+	 * ============================================================================ */
+
+	static std::mutex g_serverMutex;
+	static std::thread g_serverThread;
+	static int g_listenFd = -1;
+	static int g_wakePipe[2] = {-1, -1};
+	static std::string g_unixPath;
+
+	static void SendAll(int fd, const char *data, size_t len)
+	{
+		while (len > 0)
+		{
+			ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+			if (n <= 0)
+			{
+				return;
+			}
+			data += n;
+			len -= n;
+		}
+	}
+
+	static void ServeClient(int fd)
+	{
+		/* Don't let a stalled client hold up the accept loop */
+		struct timeval tv = {1, 0};
+		setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+		setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+		char request[2048];
+		size_t used = 0;
+		while (used < sizeof(request) - 1)
+		{
+			ssize_t n = recv(fd, request + used, sizeof(request) - 1 - used, 0);
+			if (n <= 0)
+			{
+				break;
+			}
+			used += n;
+			request[used] = '\0';
+			if (strstr(request, "\r\n\r\n") || strstr(request, "\n\n"))
+			{
+				break;
+			}
+		}
+		request[used] = '\0';
+
+		char method[8] = "";
+		char path[256] = "";
+		sscanf(request, "%7s %255s", method, path);
+
+		std::string response;
+		if (strcmp(method, "GET") != 0)
+		{
+			response = "HTTP/1.0 405 Method Not Allowed\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+		}
+		else if (strcmp(path, "/metrics") != 0 && strcmp(path, "/") != 0)
+		{
+			response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+		}
+		else
+		{
+			std::string body = FormatMetrics();
+			response = "HTTP/1.0 200 OK\r\n"
+					   "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+					   "Content-Length: " +
+					   std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+		}
+
+		SendAll(fd, response.data(), response.size());
+		close(fd);
+	}
+
+	static void MetricsServerThreadFunc(int listenFd, int wakeFd)
+	{
+		ApplyThreadPolicy(WR_THREAD_METRICS);
+		WR_DEBUG("MetricsServer: Started");
+
+		while (true)
+		{
+			struct pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+			if (poll(fds, 2, -1) < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				WR_ERROR("MetricsServer: poll failed (errno=%d)", errno);
+				break;
+			}
+
+			if (fds[1].revents)
+			{
+				break;
+			}
+
+			if (fds[0].revents & POLLIN)
+			{
+				int client = accept(listenFd, nullptr, nullptr);
+				if (client >= 0)
+				{
+					ServeClient(client);
+				}
+			}
+		}
+
+		WR_DEBUG("MetricsServer: Stopped");
+	}
+
+	static int BindEndpoint(const char *endpoint, std::string *unixPath)
+	{
+		if (strncmp(endpoint, "unix:", 5) == 0)
+		{
+			const char *path = endpoint + 5;
+			struct sockaddr_un addr;
+			memset(&addr, 0, sizeof(addr));
+			addr.sun_family = AF_UNIX;
+			if (!path[0] || strlen(path) >= sizeof(addr.sun_path))
+			{
+				return -1;
+			}
+			strcpy(addr.sun_path, path);
+
+			int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+			if (fd < 0)
+			{
+				return -1;
+			}
+
+			/* Remove a stale socket left by a previous run, but never any other file */
+			struct stat st;
+			if (lstat(path, &st) == 0)
+			{
+				if (!S_ISSOCK(st.st_mode))
+				{
+					WR_ERROR("MetricsServer: %s exists and is not a socket", path);
+					close(fd);
+					return -1;
+				}
+				unlink(path);
+			}
+			if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0)
+			{
+				WR_ERROR("MetricsServer: Cannot listen on %s (errno=%d)", path, errno);
+				close(fd);
+				return -1;
+			}
+
+			*unixPath = path;
+			return fd;
+		}
+
+		const char *colon = strrchr(endpoint, ':');
+		if (!colon)
+		{
+			return -1;
+		}
+
+		std::string host(endpoint, colon - endpoint);
+		char *end = nullptr;
+		long port = strtol(colon + 1, &end, 10);
+		if (end == colon + 1 || *end != '\0' || port <= 0 || port > 65535)
+		{
+			WR_ERROR("MetricsServer: Invalid port in %s", endpoint);
+			return -1;
+		}
+		if (host.empty() || host == "localhost")
+		{
+			host = "127.0.0.1";
+		}
+
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons((uint16_t)port);
+		if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1)
+		{
+			return -1;
+		}
+
+		int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd < 0)
+		{
+			return -1;
+		}
+
+		int reuse = 1;
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+		if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 8) != 0)
+		{
+			WR_ERROR("MetricsServer: Cannot listen on %s (errno=%d)", endpoint, errno);
+			close(fd);
+			return -1;
+		}
+
+		unixPath->clear();
+		return fd;
+	}
+
+	bool StartMetricsServer(const char *endpoint)
+	{
+		std::lock_guard<std::mutex> lock(g_serverMutex);
+
+		if (g_listenFd >= 0)
+		{
+			WR_ERROR("MetricsServer: Already running");
+			return false;
+		}
+
+		int listenFd = BindEndpoint(endpoint, &g_unixPath);
+		if (listenFd < 0)
+		{
+			return false;
+		}
+
+		if (pipe(g_wakePipe) != 0)
+		{
+			close(listenFd);
+			return false;
+		}
+
+		g_listenFd = listenFd;
+		g_serverThread = std::thread(MetricsServerThreadFunc, g_listenFd, g_wakePipe[0]);
+		WR_INFO("MetricsServer: Serving OpenMetrics on %s", endpoint);
+		return true;
+	}
+
+	void StopMetricsServer()
+	{
+		std::lock_guard<std::mutex> lock(g_serverMutex);
+
+		if (g_listenFd < 0)
+		{
+			return;
+		}
+
+		if (write(g_wakePipe[1], "x", 1) != 1)
+		{
+			WR_ERROR("MetricsServer: Failed to wake server thread");
+		}
+		if (g_serverThread.joinable())
+		{
+			g_serverThread.join();
+		}
+
+		close(g_listenFd);
+		close(g_wakePipe[0]);
+		close(g_wakePipe[1]);
+		g_listenFd = -1;
+		g_wakePipe[0] = g_wakePipe[1] = -1;
+
+		if (!g_unixPath.empty())
+		{
+			unlink(g_unixPath.c_str());
+			g_unixPath.clear();
+		}
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,61 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_METRICS_H
+#define WANDERER_ROTATOR_METRICS_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - METRICS MODULE
+ *
+ * OpenMetrics text exposition of per-device statistics, optionally served
+ * over HTTP on a localhost TCP port or a Unix domain socket.
+ * ============================================================================ */
+
+#include <string>
+
+namespace WandererRotator
+{
+	/**
+	 * Render the statistics of all open devices in OpenMetrics text format,
+	 * terminated by "# EOF".
+	 */
+	std::string FormatMetrics();
+
+	/**
+	 * Start serving metrics over HTTP in a background thread.
+	 *
+	 * @param endpoint "unix:/path/to/socket", "host:port" or ":port"
+	 *                 (an empty host binds 127.0.0.1)
+	 * @return true if the endpoint is bound and listening
+	 */
+	bool StartMetricsServer(const char *endpoint);
+
+	/**
+	 * Stop the metrics server and remove its Unix socket, if any.
+	 */
+	void StopMetricsServer();
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_METRICS_H */
@@ -0,0 +1,142 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorModels.h"
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * BUILT-IN MODELS
+	 * ============================================================================ */
+
+	static constexpr WR_MODEL_TRAITS BUILTIN_MODELS[] = {
+		/* model     steps/deg  steps/s  deg/s  overhead  settle  commands */
+		{"Mini",     1142,      5000.0f, 5.0f,  300,      100,    WR_MODEL_CMD_ALL},
+		{"Lite",     1155,      5000.0f, 5.0f,  300,      100,    WR_MODEL_CMD_ALL},
+		{"LiteV2",   1199,      5000.0f, 5.0f,  300,      100,    WR_MODEL_CMD_ALL},
+	};
+
+	static constexpr int BUILTIN_MODEL_COUNT = sizeof(BUILTIN_MODELS) / sizeof(BUILTIN_MODELS[0]);
+
+	static constexpr bool BuiltinModelsValid()
+	{
+		for (int i = 0; i < BUILTIN_MODEL_COUNT; i++)
+		{
+			const WR_MODEL_TRAITS &m = BUILTIN_MODELS[i];
+			if (m.model[0] == '\0' || m.stepsPerDegree <= 0 || m.stepRate <= 0.0f ||
+			    m.stepRate > m.maxSpeed * m.stepsPerDegree || (m.commands & WR_MODEL_CMD_MOVE) == 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static_assert(BuiltinModelsValid(), "Built-in model table has an invalid entry");
+
+	/* Fixed storage so traits pointers held by devices stay valid */
+	static WR_MODEL_TRAITS g_registeredModels[MAX_REGISTERED_MODELS];
+	static int g_registeredCount = 0;
+	static std::mutex g_modelsMutex;
+
+	/* Added to twice the expected move duration before a move is declared lost */
+	static constexpr int MOVE_TIMEOUT_MARGIN_MS = 5000;
+	/* Never give up sooner than the fixed timeout used before per-model traits */
+	static constexpr int MOVE_TIMEOUT_MIN_MS = 90000;
+
+	/* ============================================================================
+	 * LOOKUP AND REGISTRATION
+	 * ============================================================================ */
+
+	const WR_MODEL_TRAITS *FindModel(const char *model)
+	{
+		if (!model || model[0] == '\0')
+		{
+			return nullptr;
+		}
+
+		std::lock_guard<std::mutex> lock(g_modelsMutex);
+
+		/* Newest registration first, built-ins last, so overrides win */
+		for (int i = g_registeredCount - 1; i >= 0; i--)
+		{
+			if (strcmp(g_registeredModels[i].model, model) == 0)
+			{
+				return &g_registeredModels[i];
+			}
+		}
+
+		for (int i = 0; i < BUILTIN_MODEL_COUNT; i++)
+		{
+			if (strcmp(BUILTIN_MODELS[i].model, model) == 0)
+			{
+				return &BUILTIN_MODELS[i];
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool IsValidModel(const WR_MODEL_TRAITS &traits)
+	{
+		return traits.model[0] != '\0' &&
+		       memchr(traits.model, '\0', sizeof(traits.model)) != nullptr &&
+		       traits.stepsPerDegree > 0 &&
+		       traits.stepRate > 0.0f &&
+		       traits.maxSpeed > 0.0f &&
+		       traits.stepRate <= traits.maxSpeed * traits.stepsPerDegree &&
+		       traits.overheadMs >= 0 &&
+		       traits.settleMs >= 0 &&
+		       (traits.commands & WR_MODEL_CMD_MOVE) != 0 &&
+		       (traits.commands & ~WR_MODEL_CMD_ALL) == 0;
+	}
+
+	bool RegisterModel(const WR_MODEL_TRAITS &traits)
+	{
+		std::lock_guard<std::mutex> lock(g_modelsMutex);
+
+		if (g_registeredCount >= MAX_REGISTERED_MODELS)
+		{
+			return false;
+		}
+
+		g_registeredModels[g_registeredCount++] = traits;
+		return true;
+	}
+
+	int MoveTimeoutMs(const WR_MODEL_TRAITS *traits, int steps, double learnedMs)
+	{
+		double expectedMs = traits->overheadMs + 1000.0 * std::abs(steps) / traits->stepRate;
+		if (learnedMs > expectedMs)
+		{
+			expectedMs = learnedMs;
+		}
+		double timeoutMs = 2.0 * expectedMs + traits->settleMs + MOVE_TIMEOUT_MARGIN_MS;
+		return timeoutMs < MOVE_TIMEOUT_MIN_MS ? MOVE_TIMEOUT_MIN_MS : (int)timeoutMs;
+	}
+
+} /* namespace WandererRotator */
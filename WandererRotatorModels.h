@@ -0,0 +1,81 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_MODELS_H
+#define WANDERER_ROTATOR_MODELS_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - MODELS MODULE
+ *
+ * Per-model hardware constants. Built-in models live in a compile-time
+ * table, applications can add or override models with WRRegisterModel().
+ * A device resolves its model each time it is opened and keeps a pointer
+ * to the traits; entries are never freed or modified.
+ * ============================================================================ */
+
+#include "WandererRotatorSDK.h"
+
+namespace WandererRotator
+{
+	/* Registered models on top of the built-in table */
+	static constexpr int MAX_REGISTERED_MODELS = 16;
+
+	/**
+	 * Find the traits for a model name reported by the device. Only an
+	 * exact name match counts, so an unknown revision such as "MiniXL"
+	 * never runs on another model's constants. Registered models take
+	 * precedence over built-in ones, later registrations over earlier ones.
+	 *
+	 * @param model Model name from the handshake, e.g. "LiteV2"
+	 * @return Traits, or nullptr if the model is unknown
+	 */
+	const WR_MODEL_TRAITS *FindModel(const char *model);
+
+	/**
+	 * Check that traits are complete and self-consistent.
+	 */
+	bool IsValidModel(const WR_MODEL_TRAITS &traits);
+
+	/**
+	 * Add a model to the registry.
+	 *
+	 * @return false if the registry is full
+	 */
+	bool RegisterModel(const WR_MODEL_TRAITS &traits);
+
+	/**
+	 * Time to wait for a move's completion report before giving up:
+	 * twice the longer of the nominal and learned durations plus settling
+	 * and a fixed margin, and never less than 90 seconds.
+	 *
+	 * @param traits Model traits
+	 * @param steps Signed step count of the move phase
+	 * @param learnedMs Duration predicted from completed moves, 0 if none
+	 * @return Timeout in milliseconds
+	 */
+	int MoveTimeoutMs(const WR_MODEL_TRAITS *traits, int steps, double learnedMs);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_MODELS_H */
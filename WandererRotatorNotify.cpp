@@ -0,0 +1,299 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorNotify.h"
+#include "WandererRotatorSkyModel.h"
+#include "WandererRotatorThreads.h"
+#include "WandererRotatorTrace.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace WandererRotator
+{
+	struct Subscription
+	{
+		std::shared_ptr<Device> device;
+		WR_SUBSCRIPTION filter;
+		WR_NOTIFY_CALLBACK callback;
+		void *context;
+		unsigned int pending = 0;		/* Changes not yet delivered */
+		WR_NOTIFICATION latest;			/* Device state at the most recent change */
+		long long nextAllowedUs = 0;	/* Earliest time of the next notification */
+		float deliveredPosition = 0.0f; /* Position of the last notification */
+	};
+
+	struct Delivery
+	{
+		int handle;
+		WR_NOTIFY_CALLBACK callback;
+		void *context;
+		WR_NOTIFICATION notification;
+	};
+
+	static std::mutex g_notifyMutex;
+	static std::condition_variable g_notifyCondition;
+	static std::map<int, Subscription> g_subscriptions;
+	static int g_nextHandle = 1;
+	static int g_deliveringHandle = 0; /* Handle whose callback is running, 0 if none */
+	static unsigned int g_generation = 0; /* Bumped to stop the current dispatcher */
+	static std::thread g_dispatcher;
+
+	/* Stops a dispatcher still running at unload, a joinable std::thread would terminate */
+	static struct DispatcherReaper
+	{
+		~DispatcherReaper()
+		{
+			std::unique_lock<std::mutex> lock(g_notifyMutex);
+			if (!g_dispatcher.joinable())
+			{
+				return;
+			}
+			g_generation++;
+			g_notifyCondition.notify_all();
+			lock.unlock();
+			g_dispatcher.join();
+		}
+	} g_dispatcherReaper;
+
+	/* Longest idle wait, bounds the delay of a lost wake-up */
+	static const long long NOTIFY_IDLE_WAIT_US = 1000000;
+
+	/* Device state as seen by the producer, which owns it at this point */
+	static void CaptureState(const std::shared_ptr<Device> &device, WR_NOTIFICATION *state)
+	{
+		memset(state, 0, sizeof(*state));
+		state->id = device->id;
+		state->status.position = device->status.position;
+		state->status.moving = device->status.moving;
+		state->status.stepsPerRevolution = device->status.stepsPerRevolution;
+		state->status.stepSize = device->status.stepSize;
+		state->lastMoveError = device->stats.lastMoveError;
+		state->timeouts = device->stats.timeouts;
+		state->parseErrors = device->stats.parseErrors;
+	}
+
+	/* Caller holds g_notifyMutex. Returns false if nothing is left to report. */
+	static bool BuildNotification(int handle, Subscription &sub, WR_NOTIFICATION *notification)
+	{
+		unsigned int changes = sub.pending & sub.filter.mask;
+		sub.pending = 0;
+
+		if (changes & WR_NOTIFY_POSITION)
+		{
+			float moved = (float)WrapDegrees(sub.latest.status.position - sub.deliveredPosition);
+			if (moved == 0.0f || fabsf(moved) < sub.filter.positionThreshold)
+			{
+				changes &= ~WR_NOTIFY_POSITION;
+			}
+		}
+
+		if (!changes)
+		{
+			return false;
+		}
+
+		*notification = sub.latest;
+		notification->handle = handle;
+		notification->changes = changes;
+		notification->timestampUs = TraceNowUs();
+
+		sub.deliveredPosition = sub.latest.status.position;
+		return true;
+	}
+
+	static void DispatcherThreadFunc(unsigned int generation)
+	{
+		unsigned int policyGeneration = ThreadPolicyGeneration(WR_THREAD_NOTIFY);
+		ApplyThreadPolicy(WR_THREAD_NOTIFY);
+
+		std::unique_lock<std::mutex> lock(g_notifyMutex);
+		std::vector<Delivery> deliveries;
+
+		while (g_generation == generation)
+		{
+			/* Lives as long as there are subscriptions, pick up a changed policy */
+			if (ThreadPolicyGeneration(WR_THREAD_NOTIFY) != policyGeneration)
+			{
+				policyGeneration = ThreadPolicyGeneration(WR_THREAD_NOTIFY);
+				ApplyThreadPolicy(WR_THREAD_NOTIFY, true);
+			}
+
+			long long nowUs = TraceNowUs();
+			long long wakeUs = nowUs + NOTIFY_IDLE_WAIT_US;
+
+			deliveries.clear();
+			for (auto &entry : g_subscriptions)
+			{
+				Subscription &sub = entry.second;
+				if (!sub.pending)
+				{
+					continue;
+				}
+
+				/* Over its rate, keep coalescing until the next slot */
+				if (nowUs < sub.nextAllowedUs)
+				{
+					wakeUs = std::min(wakeUs, sub.nextAllowedUs);
+					continue;
+				}
+
+				Delivery delivery;
+				if (BuildNotification(entry.first, sub, &delivery.notification))
+				{
+					delivery.handle = entry.first;
+					delivery.callback = sub.callback;
+					delivery.context = sub.context;
+					deliveries.push_back(delivery);
+					if (sub.filter.maxRate > 0.0f)
+					{
+						sub.nextAllowedUs = nowUs + (long long)(1000000.0f / sub.filter.maxRate);
+					}
+				}
+			}
+
+			if (deliveries.empty())
+			{
+				g_notifyCondition.wait_for(lock, std::chrono::microseconds(wakeUs - nowUs));
+				continue;
+			}
+
+			/* Callbacks run unlocked, a subscription removed meanwhile is skipped */
+			for (const Delivery &delivery : deliveries)
+			{
+				if (g_generation != generation)
+				{
+					break;
+				}
+				if (!g_subscriptions.count(delivery.handle))
+				{
+					continue;
+				}
+
+				g_deliveringHandle = delivery.handle;
+				lock.unlock();
+				delivery.callback(&delivery.notification, delivery.context);
+				lock.lock();
+				g_deliveringHandle = 0;
+				g_notifyCondition.notify_all();
+			}
+		}
+	}
+
+	void NotifyChange(const std::shared_ptr<Device> &device, unsigned int changes)
+	{
+		if (device->subscribers.load(std::memory_order_relaxed) == 0)
+		{
+			return;
+		}
+
+		WR_NOTIFICATION state;
+		CaptureState(device, &state);
+
+		std::lock_guard<std::mutex> lock(g_notifyMutex);
+		bool wake = false;
+		for (auto &entry : g_subscriptions)
+		{
+			Subscription &sub = entry.second;
+			if (sub.device != device)
+			{
+				continue;
+			}
+
+			/* Coalesce: keep only the newest state */
+			sub.latest = state;
+			if (changes & sub.filter.mask)
+			{
+				sub.pending |= changes;
+				wake = true;
+			}
+		}
+
+		if (wake)
+		{
+			g_notifyCondition.notify_all();
+		}
+	}
+
+	int Subscribe(const std::shared_ptr<Device> &device, const WR_SUBSCRIPTION &filter,
+				  WR_NOTIFY_CALLBACK callback, void *context)
+	{
+		std::lock_guard<std::mutex> lock(g_notifyMutex);
+
+		int handle = g_nextHandle++;
+		Subscription &sub = g_subscriptions[handle];
+		sub.device = device;
+		sub.filter = filter;
+		sub.callback = callback;
+		sub.context = context;
+		CaptureState(device, &sub.latest);
+		sub.deliveredPosition = sub.latest.status.position;
+		device->subscribers++;
+
+		if (!g_dispatcher.joinable())
+		{
+			g_dispatcher = std::thread(DispatcherThreadFunc, g_generation);
+		}
+
+		return handle;
+	}
+
+	bool Unsubscribe(int handle)
+	{
+		std::unique_lock<std::mutex> lock(g_notifyMutex);
+
+		auto it = g_subscriptions.find(handle);
+		if (it == g_subscriptions.end())
+		{
+			return false;
+		}
+
+		it->second.device->subscribers--;
+		g_subscriptions.erase(it);
+
+		bool onDispatcher = std::this_thread::get_id() == g_dispatcher.get_id();
+		if (!onDispatcher)
+		{
+			/* Don't return while its callback is still running */
+			g_notifyCondition.wait(lock, [handle] { return g_deliveringHandle != handle; });
+		}
+
+		/* Stop the dispatcher with the last subscription (from inside it, the next call does) */
+		if (g_subscriptions.empty() && !onDispatcher && g_dispatcher.joinable())
+		{
+			g_generation++;
+			g_notifyCondition.notify_all();
+			std::thread dispatcher = std::move(g_dispatcher);
+			lock.unlock();
+			dispatcher.join();
+		}
+
+		return true;
+	}
+
+} /* namespace WandererRotator */
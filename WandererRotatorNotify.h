@@ -0,0 +1,69 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_NOTIFY_H
+#define WANDERER_ROTATOR_NOTIFY_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - NOTIFICATIONS MODULE
+ *
+ * State change subscriptions. Producers overwrite the latest state and
+ * mark what changed; a single dispatcher thread ("wr-notify") delivers it
+ * when the subscription's rate limit allows, so intermediate updates are
+ * coalesced and slow consumers never see a backlog. Costs nothing while
+ * a device has no subscribers.
+ * ============================================================================ */
+
+#include "WandererRotatorDevice.h"
+
+namespace WandererRotator
+{
+	/**
+	 * Record a state change of a device for its subscribers. Call after
+	 * the change, from the thread that made it.
+	 *
+	 * @param device Device whose state changed
+	 * @param changes WR_NOTIFY_xxx bits
+	 */
+	void NotifyChange(const std::shared_ptr<Device> &device, unsigned int changes);
+
+	/**
+	 * Add a subscription, starting the dispatcher thread if needed.
+	 *
+	 * @return Subscription handle (> 0)
+	 */
+	int Subscribe(const std::shared_ptr<Device> &device, const WR_SUBSCRIPTION &filter,
+				  WR_NOTIFY_CALLBACK callback, void *context);
+
+	/**
+	 * Remove a subscription. Once this returns its callback is not running
+	 * and will not be called again, unless called from that callback.
+	 *
+	 * @return false if the handle is unknown
+	 */
+	bool Unsubscribe(int handle);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_NOTIFY_H */
@@ -0,0 +1,90 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorProfiles.h"
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace WandererRotator
+{
+	static std::map<std::string, WR_PROFILE> g_profiles;
+	static std::mutex g_profilesMutex;
+
+	static bool IsValidName(const char *name)
+	{
+		return name && name[0] != '\0' && strnlen(name, WR_PROFILE_NAME_LEN) < WR_PROFILE_NAME_LEN;
+	}
+
+	bool IsValidProfile(const WR_PROFILE &profile)
+	{
+		return profile.config.backlash >= 0.0f &&
+		       profile.config.overshootAngle >= 0.0f &&
+		       profile.config.overshotDirection >= 0 &&
+		       profile.deadband >= 0.0f && profile.deadband < 180.0f;
+	}
+
+	bool SaveProfile(const char *name, const WR_PROFILE &profile)
+	{
+		if (!IsValidName(name))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(g_profilesMutex);
+		g_profiles[name] = profile;
+		return true;
+	}
+
+	bool FindProfile(const char *name, WR_PROFILE *profile)
+	{
+		if (!IsValidName(name))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(g_profilesMutex);
+		auto it = g_profiles.find(name);
+		if (it == g_profiles.end())
+		{
+			return false;
+		}
+
+		*profile = it->second;
+		return true;
+	}
+
+	bool DeleteProfile(const char *name)
+	{
+		if (!IsValidName(name))
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(g_profilesMutex);
+		return g_profiles.erase(name) > 0;
+	}
+
+} /* namespace WandererRotator */
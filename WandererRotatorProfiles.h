@@ -0,0 +1,67 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_PROFILES_H
+#define WANDERER_ROTATOR_PROFILES_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - PROFILES MODULE
+ *
+ * Named configuration profiles, shared by all devices, applied in one
+ * batch by WRRotatorApplyProfile().
+ * ============================================================================ */
+
+#include "WandererRotatorSDK.h"
+
+namespace WandererRotator
+{
+	/**
+	 * Check that every field of a profile is in range.
+	 */
+	bool IsValidProfile(const WR_PROFILE &profile);
+
+	/**
+	 * Store a profile, replacing one of the same name.
+	 *
+	 * @return false if the name is empty or too long
+	 */
+	bool SaveProfile(const char *name, const WR_PROFILE &profile);
+
+	/**
+	 * Look up a profile by name.
+	 *
+	 * @return false if no such profile exists
+	 */
+	bool FindProfile(const char *name, WR_PROFILE *profile);
+
+	/**
+	 * Remove a profile.
+	 *
+	 * @return false if no such profile exists
+	 */
+	bool DeleteProfile(const char *name);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_PROFILES_H */
@@ -23,18 +23,63 @@
  * **************************************************************************** */
 
 #include "WandererRotatorProtocol.h"
+#include "WandererRotatorSDK.h"
 #include "WandererRotatorLogging.h"
+#include "WandererRotatorTrace.h"
+#include "WandererRotatorThreads.h"
+#include "WandererRotatorEvents.h"
+#include "WandererRotatorModels.h"
+#include "WandererRotatorNotify.h"
 #include <cstring>
+#include <cctype>
+#include <cmath>
 #include <cstdio>
 #include <unistd.h>
 #include <termios.h>
 #include <thread>
 #include <atomic>
 #include <memory>
+#include <algorithm>
 
 namespace WandererRotator
 {
-    bool SendCommand(std::shared_ptr<Device> device, const char *command, int timeoutMs)
+    /* Record a response field that could not be parsed */
+    static void NoteParseError(const std::shared_ptr<Device> &device, const char *ctx, const char *raw)
+    {
+        device->stats.parseErrors++;
+        WR_WARN("Invalid message on %s (%s)", device->portName.c_str(), ctx);
+        if (TraceEnabled())
+        {
+            char text[64];
+            TraceWrite(device->portName.c_str(), WR_TRACE_PARSE, "ctx=%s data=%s",
+                       ctx, TraceData((const unsigned char *)raw, strlen(raw), text, sizeof(text)));
+        }
+        NotifyChange(device, WR_NOTIFY_ERROR);
+    }
+
+    /* Record a response field that never arrived after waiting waitedMs */
+    static void NoteTimeout(const std::shared_ptr<Device> &device, int waitedMs)
+    {
+        device->stats.timeouts++;
+        WR_WARN("Response timeout on %s after %d ms", device->portName.c_str(), waitedMs);
+
+        WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_TIMEOUT);
+        entry.error = WR_ERROR_COMMUNICATION;
+        entry.elapsedMs = waitedMs;
+        device->history.Record(entry);
+
+        NotifyChange(device, WR_NOTIFY_ERROR);
+    }
+
+    /* Record the round trip of a completed query */
+    static void NoteRoundTrip(const std::shared_ptr<Device> &device, const char *type, long long sentUs)
+    {
+        long long us = TraceNowUs() - sentUs;
+        device->stats.latency.Record(us / 1000.0);
+        WR_TRACE(device->portName.c_str(), WR_TRACE_RTT, "type=%s us=%lld", type, us);
+    }
+
+    bool SendCommand(const std::shared_ptr<Device> &device, const char *command, int timeoutMs)
     {
         if (!device || !device->port || !device->port->IsOpen())
         {
@@ -44,10 +89,11 @@ namespace WandererRotator
             return false;
         }
 
-        // 100 ms delay
-        usleep(100000);
+        // Inter-command gap (100 ms unless tuned by a link test)
+        usleep(device->commandGapMs * 1000);
 
         WR_DEBUG("SendCommand: Writing '%s'", command);
+        device->stats.commands++;
         if (!device->port->Write((const unsigned char *)command, strlen(command)))
         {
             WR_DEBUG("SendCommand: Write failed");
@@ -57,7 +103,7 @@ namespace WandererRotator
         return true;
     }
 
-    bool QueryHandshake(std::shared_ptr<Device> device)
+    bool QueryHandshake(const std::shared_ptr<Device> &device)
     {
         if (!device || !device->port)
         {
@@ -72,28 +118,36 @@ namespace WandererRotator
             return false;
         }
 
-        // 100 ms delay
-        usleep(100000);
+        // Inter-command gap (100 ms unless tuned by a link test)
+        usleep(device->commandGapMs * 1000);
 
         int retries = 0;
         char response[32];
 
         while (retries++ < 5)
         {
-            tcflush(device->port->GetFD(), TCIOFLUSH);
+            device->port->FlushInput();
+            device->stats.commands++;
+            long long sentUs = TraceNowUs();
             if (!device->port->Write((const unsigned char *)"1500001\n", 8))
             {
                 WR_DEBUG("Handshake: Writing to serial failed");
                 return false;
             }
 
-            if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+            if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
             {
                 if (strstr(response, "WandererRotator") != NULL)
                 {
+                    NoteRoundTrip(device, "handshake", sentUs);
                     printf("Found after %d retries", retries);
                     return true;
                 }
+                NoteParseError(device, "handshake", response);
+            }
+            else
+            {
+                NoteTimeout(device, device->responseTimeoutMs);
             }
 
             // 200 ms delay
@@ -104,7 +158,7 @@ namespace WandererRotator
         return false;
     }
 
-    bool QueryStatus(std::shared_ptr<Device> device)
+    bool QueryStatus(const std::shared_ptr<Device> &device)
     {
         if (!device || !device->port)
         {
@@ -120,12 +174,14 @@ namespace WandererRotator
             return false;
         }
 
-        // 100 ms delay
-        usleep(100000);
+        // Inter-query gap (100 ms unless tuned by a link test)
+        usleep(device->queryGapMs * 1000);
 
         char response[32];
 
-        tcflush(device->port->GetFD(), TCIOFLUSH);
+        device->port->FlushInput();
+        device->stats.commands++;
+        long long sentUs = TraceNowUs();
         if (!device->port->Write((const unsigned char *)"1500001\n", 8))
         {
             WR_DEBUG("QueryStatus: Writing to serial failed");
@@ -133,116 +189,258 @@ namespace WandererRotator
         }
 
         // Read handshake tag and model
-        if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+        if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
         {
             char model[8];
             if (sscanf(response, "WandererRotator%7[^A]A", model) != 1)
             {
                 WR_DEBUG("QueryStatus: invalid message %s", response);
+                NoteParseError(device, "status.model", response);
                 return false;
             }
 
-            device->modelType = std::string(model);
+            /* Same model every time, skip the string rewrite */
+            if (device->modelType != model)
+            {
+                device->modelType = model;
+            }
         }
         else
         {
             WR_DEBUG("QueryStatus: timeout reading model from serial");
+            NoteTimeout(device, device->responseTimeoutMs);
             return false;
         }
 
         // Read firmware
-        if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+        if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
         {
             if (sscanf(response, "%dA", &device->firmwareVersion) != 1)
             {
                 WR_DEBUG("QueryStatus: invalid message %s", response);
+                NoteParseError(device, "status.firmware", response);
                 return false;
             }
         }
         else
         {
             WR_DEBUG("QueryStatus: timeout reading firmware from serial");
+            NoteTimeout(device, device->responseTimeoutMs);
             return false;
         }
 
         // Read mechanical position
-        if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+        device->positionValid = false;
+        if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
         {
             if (sscanf(response, "%dA", &device->mechanicalAngle) != 1)
             {
                 WR_DEBUG("QueryStatus: invalid message %s", response);
+                NoteParseError(device, "status.position", response);
                 return false;
             }
+            device->positionValid = true;
         }
         else
         {
             WR_DEBUG("QueryStatus: timeout reading position from serial");
+            NoteTimeout(device, device->responseTimeoutMs);
             return false;
         }
 
         // Read backlash
-        if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+        if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
         {
             float backlash;
             if (sscanf(response, "%fA", &backlash) != 1)
             {
                 WR_DEBUG("QueryStatus: invalid message %s", response);
+                NoteParseError(device, "status.backlash", response);
                 return false;
             }
-            device->backlash = backlash * 10.0f;
+            device->backlash = (int)lroundf(backlash * 10.0f);
         }
         else
         {
             WR_DEBUG("QueryStatus: timeout reading backlash from serial");
+            NoteTimeout(device, device->responseTimeoutMs);
             return false;
         }
 
         // Read reverse state
-        if (device->port->Read((unsigned char *)response, 32, 'A', 3000))
+        if (device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs))
         {
             if (sscanf(response, "%dA", &device->reverseDirection) != 1)
             {
                 WR_DEBUG("QueryStatus: invalid message %s", response);
+                NoteParseError(device, "status.reverse", response);
                 return false;
             }
         }
         else
         {
             WR_DEBUG("QueryStatus: timeout reading reverse state from serial");
+            NoteTimeout(device, device->responseTimeoutMs);
             return false;
         }
 
-        /* Set steps per degree based on model type */
-        if (device->modelType.find("Mini") != std::string::npos)
-        {
-            device->stepsPerDegree = 1142;
-        }
-        else if (device->modelType.find("Lite") != std::string::npos)
+        NoteRoundTrip(device, "status", sentUs);
+
+        /* Resolve the model's hardware constants, on open and whenever the model changes */
+        if (!device->traits || device->modelType != device->traits->model)
         {
-            if (device->modelType.find("V2") != std::string::npos)
+            const WR_MODEL_TRAITS *traits = FindModel(device->modelType.c_str());
+            if (!traits)
             {
-                device->stepsPerDegree = 1199;
-            }
-            else
-            {
-                device->stepsPerDegree = 1155;
+                WR_ERROR("QueryStatus: unknown model '%s', register it with WRRegisterModel()",
+                         device->modelType.c_str());
+                device->traits = nullptr;
+                return false;
             }
+
+            device->traits = traits;
+            device->stepsPerDegree = traits->stepsPerDegree;
+            device->stats.moveModel.SetNominal(traits->stepRate, traits->overheadMs);
         }
 
         device->status.stepsPerRevolution = device->stepsPerDegree * 360;
         device->status.stepSize = 1.0f / device->stepsPerDegree;
 
         /* Set initial position from mechanical angle */
-        device->status.position = device->mechanicalAngle / 1000.0f;
+        UpdatePosition(device);
 
         WR_DEBUG("QueryStatus: Successfully parsed, model=%s steps=%d",
                  device->modelType.c_str(), device->stepsPerDegree);
         return true;
     }
 
+    /* Check that a status field is a number terminated by 'A' */
+    static bool IsNumericField(const char *field, int len)
+    {
+        if (len < 2 || field[len - 1] != 'A')
+        {
+            return false;
+        }
+
+        for (int i = 0; i < len - 1; i++)
+        {
+            if (!isdigit((unsigned char)field[i]) && field[i] != '-' && field[i] != '.')
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool QueryLinkProbe(const std::shared_ptr<Device> &device, int gapMs, LinkProbe *probe)
+    {
+        if (!device || !device->port || !device->port->IsOpen() || !probe)
+        {
+            return false;
+        }
+
+        *probe = LinkProbe();
+
+        if (gapMs > 0)
+        {
+            usleep(gapMs * 1000);
+        }
+
+        device->port->FlushInput();
+        device->stats.commands++;
+        long long sentUs = TraceNowUs();
+        if (!device->port->Write((const unsigned char *)"1500001\n", 8))
+        {
+            return false;
+        }
+
+        /* Model, firmware, position, backlash and reverse state */
+        bool intact = true;
+        char response[32];
+        for (int field = 0; field < 5; field++)
+        {
+            int len = device->port->Read((unsigned char *)response, 32, 'A', device->responseTimeoutMs);
+            probe->bytesReceived += len;
+
+            bool valid = (field == 0)
+                             ? (strncmp(response, "WandererRotator", 15) == 0 && len > 16 && response[len - 1] == 'A')
+                             : IsNumericField(response, len);
+            if (!valid)
+            {
+                probe->errorBytes += len > 0 ? len : 1;
+                intact = false;
+                if (len == 0)
+                {
+                    NoteTimeout(device, device->responseTimeoutMs);
+                    /* Nothing more is coming, don't wait out the remaining fields */
+                    break;
+                }
+            }
+        }
+
+        probe->roundTripUs = TraceNowUs() - sentUs;
+        if (intact)
+        {
+            NoteRoundTrip(device, "linktest", sentUs);
+        }
+        return intact;
+    }
+
+    int AngleToSteps(const std::shared_ptr<Device> &device, float degrees)
+    {
+        /* NaN/inf or a huge angle would overflow the int conversion */
+        if (!std::isfinite(degrees))
+        {
+            return 0;
+        }
+        double clamped = std::max(-360.0, std::min(360.0, (double)degrees));
+        return (int)lround(clamped * device->stepsPerDegree);
+    }
+
+    int MilliDegreesToSteps(const std::shared_ptr<Device> &device, int milliDegrees)
+    {
+        long long scaled = (long long)milliDegrees * device->stepsPerDegree;
+        long long half = (scaled >= 0) ? 500 : -500;
+        return (int)((scaled + half) / 1000);
+    }
+
+    int ShortestDeltaMilliDegrees(int fromMilliDegrees, int toMilliDegrees)
+    {
+        int delta = (toMilliDegrees - fromMilliDegrees) % MILLIDEGREES_PER_REVOLUTION;
+        delta = (delta + MILLIDEGREES_PER_REVOLUTION + MILLIDEGREES_PER_REVOLUTION / 2) % MILLIDEGREES_PER_REVOLUTION;
+        return delta - MILLIDEGREES_PER_REVOLUTION / 2;
+    }
+
+    void UpdatePosition(const std::shared_ptr<Device> &device)
+    {
+        std::shared_ptr<const CorrectionTable> table = std::atomic_load(&device->correction);
+        int milliDegrees = table ? table->ToTrue(device->mechanicalAngle) : device->mechanicalAngle;
+        device->status.position = milliDegrees / 1000.0f; /* Convert from *1000 format to degrees */
+        NotifyChange(device, WR_NOTIFY_POSITION);
+    }
+
+    int TargetMilliDegrees(const std::shared_ptr<Device> &device, float degrees)
+    {
+        int milliDegrees = (int)lround(degrees * 1000.0) % MILLIDEGREES_PER_REVOLUTION;
+        std::shared_ptr<const CorrectionTable> table = std::atomic_load(&device->correction);
+        return table ? table->ToMechanical(milliDegrees) : milliDegrees;
+    }
+
+    bool MoveToCommand(int steps, char *cmd, int len)
+    {
+        /* The device reads the command as 1000000 + steps, which must stay a positive 7 digit number */
+        if (steps <= -1000000 || steps >= 9000000)
+        {
+            return false;
+        }
+
+        snprintf(cmd, len, "%d", 1000000 + steps);
+        return true;
+    }
+
     int BacklashToCommand(float backlash)
     {
-        return (int)(backlash * 10.0f) + 1600000;
+        return (int)lroundf(backlash * 10.0f) + 1600000;
     }
 
     const char *ReverseDirectionToCommand(int reverse)
@@ -250,8 +448,93 @@ namespace WandererRotator
         return reverse ? "1700001\n" : "1700000\n";
     }
 
-    /* Background listener thread function for movement completion */
-    static void MoveListenerThreadFunc(std::shared_ptr<Device> device)
+    void NoteMoveSubmitted(const std::shared_ptr<Device> &device, int steps, int remainingSteps)
+    {
+        DeviceStats &stats = device->stats;
+        double expectedMs = stats.moveModel.PredictMs(steps);
+        if (remainingSteps > 0)
+        {
+            expectedMs += stats.moveModel.PredictMs(remainingSteps);
+        }
+
+        device->moveSteps = steps;
+        stats.moves++;
+        stats.moveStartUs = TraceNowUs();
+        stats.moveExpectedMs = (int)expectedMs;
+
+        WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, device->overshooting == 2 ? WR_HISTORY_MOVE_PHASE
+                                                                                     : WR_HISTORY_MOVE_SUBMITTED);
+        entry.steps = steps;
+        entry.expectedMs = (int)expectedMs;
+        device->history.Record(entry);
+
+        WR_TRACE(device->portName.c_str(), WR_TRACE_MOVE, "steps=%d phase=%d", steps, device->overshooting);
+    }
+
+    int RemainingMoveMs(const Device &device)
+    {
+        if (!device.status.moving)
+        {
+            return 0;
+        }
+
+        long long elapsedMs = (TraceNowUs() - device.stats.moveStartUs) / 1000;
+        long long remainingMs = device.stats.moveExpectedMs - elapsedMs;
+        return remainingMs > 0 ? (int)remainingMs : 0;
+    }
+
+    /* Record the end of a move and tell the application. Called by the listener
+     * under the device lock, which is released before the event goes out. This
+     * also ends the listener's run, before any API call can arm the next one.
+     */
+    static void NoteMoveFinished(DeviceLock &lock, const std::shared_ptr<Device> &device, WR_ERROR_TYPE error)
+    {
+        device->stats.lastMoveError = error;
+        device->stats.moveExpectedMs = 0;
+        device->stats.movesFinished++;
+
+        WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_MOVE_COMPLETE);
+        entry.steps = device->requestedSteps;
+        entry.rotated = device->lastRotated;
+        entry.error = error;
+        entry.elapsedMs = (int)((entry.timestampUs - device->stats.moveStartUs) / 1000);
+        device->history.Record(entry);
+        NotifyChange(device, error == WR_SUCCESS ? WR_NOTIFY_MOVING : WR_NOTIFY_MOVING | WR_NOTIFY_ERROR);
+
+        WR_EVENT event = MakeEvent(device, WR_EVENT_MOVE_COMPLETE);
+        event.steps = device->requestedSteps;
+        event.rotated = device->lastRotated;
+        event.error = error;
+
+        device->listenerRunning = false;
+        lock.Unlock();
+        EmitEvent(device, event);
+    }
+
+    /* Record a move whose completion feedback never arrived intact. The
+     * device is no longer tracked as moving, so a lost report can't leave
+     * it stuck in that state.
+     */
+    static void NoteMoveFailed(DeviceLock &lock, const std::shared_ptr<Device> &device)
+    {
+        device->overshooting = 0;
+        device->status.moving = 0;
+        device->positionValid = false;
+        NoteMoveFinished(lock, device, WR_ERROR_COMMUNICATION);
+    }
+
+    /* Give up on a move before its feedback was applied */
+    static void AbandonMove(const std::shared_ptr<Device> &device)
+    {
+        DeviceLock lock(device, __func__);
+        NoteMoveFailed(lock, device);
+    }
+
+    /* Read the feedback of one move phase. The port is read without the
+     * device lock, so API calls such as WRRotatorStopMove() get through
+     * while the rotator turns; the results are applied under it.
+     */
+    static void ListenForMove(const std::shared_ptr<Device> &device)
     {
         if (!device || !device->port)
         {
@@ -263,123 +546,197 @@ namespace WandererRotator
         if (!device->port->IsOpen())
         {
             WR_DEBUG("MoveListener: Port not open, exiting");
-            device->listenerRunning = false;
+            AbandonMove(device);
             return;
         }
 
+        int timeoutMs;
+        int responseTimeoutMs;
+        {
+            DeviceLock lock(device, __func__);
+            timeoutMs = device->traits
+                            ? MoveTimeoutMs(device->traits, device->moveSteps, device->stats.moveModel.PredictMs(device->moveSteps))
+                            : 90000;
+            responseTimeoutMs = device->responseTimeoutMs;
+        }
+
         char buffer[32];
+        float rotated;
+        int mechanicalAngle;
 
         // Read the actual angle moved
-        if (device->port->Read((unsigned char *)buffer, 32, 'A', 90000))
+        if (device->port->Read((unsigned char *)buffer, 32, 'A', timeoutMs))
         {
-            if (sscanf(buffer, "%fA", &device->lastRotated) != 1)
+            if (sscanf(buffer, "%fA", &rotated) != 1)
             {
                 WR_DEBUG("MoveListener: Invalid message");
-                device->listenerRunning = false;
+                NoteParseError(device, "move.rotated", buffer);
+                AbandonMove(device);
                 return;
             }
         }
         else
         {
             WR_DEBUG("MoveListener: Timeout reading from port");
-            device->listenerRunning = false;
+            NoteTimeout(device, timeoutMs);
+            AbandonMove(device);
             return;
         }
 
         // Read the new position
-        if (device->port->Read((unsigned char *)buffer, 32, 'A', 3000))
+        if (!device->port->Read((unsigned char *)buffer, 32, 'A', responseTimeoutMs))
+        {
+            WR_DEBUG("MoveListener: Timeout reading from port");
+            NoteTimeout(device, responseTimeoutMs);
+            AbandonMove(device);
+            return;
+        }
+
+        if (sscanf(buffer, "%dA", &mechanicalAngle) != 1)
         {
-            if (sscanf(buffer, "%dA", &device->mechanicalAngle) != 1)
+            WR_DEBUG("MoveListener: Invalid message");
+            NoteParseError(device, "move.position", buffer);
+            AbandonMove(device);
+            return;
+        }
+
+        DeviceLock lock(device, __func__);
+        device->lastRotated = rotated;
+        device->mechanicalAngle = mechanicalAngle;
+        device->positionValid = true;
+        UpdatePosition(device);
+        WR_TRACE(device->portName.c_str(), WR_TRACE_DONE, "rotated=%.3f position=%d phase=%d",
+                 device->lastRotated, device->mechanicalAngle, device->overshooting);
+        device->stats.moveModel.Add(device->moveSteps, (TraceNowUs() - device->stats.moveStartUs) / 1000.0);
+
+        /* Check if we need to perform second phase of overshoot compensation */
+        if (device->overshooting == 1)
+        {
+            device->overshooting = 2; /* Mark that first phase is done, ready for return */
+            /* Keep moving = 1 since we have a second phase to do */
+
+            WR_INFO("Backlash compensation: returning from overshoot by %.2f degrees", device->overshootAngle);
+
+            /* Let the mechanics settle before returning */
+            int settleMs = device->traits ? device->traits->settleMs : 100;
+            lock.Unlock();
+            usleep(settleMs * 1000);
+            lock.Relock();
+
+            /* WRRotatorStopMove() while settling cancels the return */
+            if (device->overshooting != 2)
             {
-                WR_DEBUG("MoveListener: Invalid message");
-                device->listenerRunning = false;
+                WR_INFO("Backlash compensation cancelled by stop");
+                NoteMoveFinished(lock, device, WR_SUCCESS);
                 return;
             }
-            device->status.position = device->mechanicalAngle / 1000.0f; /* Convert from *1000 format to degrees */
 
-            /* Check if we need to perform second phase of overshoot compensation */
-            if (device->overshooting == 1)
-            {
-                device->overshooting = 2; /* Mark that first phase is done, ready for return */
-                /* Keep moving = 1 since we have a second phase to do */
+            /* Move back by the overshoot amount to land on the actual target */
+            char cmd[16];
+            MoveToCommand(device->overshootReturnSteps, cmd, sizeof(cmd));
 
-                WR_INFO("Backlash compensation: returning from overshoot by %.2f degrees", device->overshootAngle);
+            WR_DEBUG("Return move command: %s", cmd);
 
-                /* Small delay before returning */
-                usleep(100000);
+            device->port->FlushInput();
 
-                /* Move back by the overshoot amount to land on the actual target */
-                float returnAngle = (device->targetAngle > 0.0f) ? -device->overshootAngle : device->overshootAngle;
-                int command_value = 1000000 + (int)(returnAngle * device->stepsPerDegree);
-                char cmd[16];
-                snprintf(cmd, sizeof(cmd), "%d", command_value);
+            if (!SendCommand(device, cmd))
+            {
+                WR_ERROR("Failed to send return movement command");
+                NoteMoveFailed(lock, device);
+                return;
+            }
 
-                WR_DEBUG("Return move command: %s", cmd);
+            device->status.moving = 1;
+            NoteMoveSubmitted(device, device->overshootReturnSteps, 0);
 
-                tcflush(device->port->GetFD(), TCIFLUSH); /* Flush input buffer */
+            /* Re-arm this listener for the return movement, staying marked running
+             * so the move is never seen as orphaned in between
+             */
+            StartMoveListener(device);
+            return;
+        }
+        else if (device->overshooting == 2)
+        {
+            /* Second phase complete */
+            WR_INFO("Backlash compensation complete, at %.3f degrees", device->status.position);
+            device->overshooting = 0;
+            device->status.moving = 0;
+            NoteMoveFinished(lock, device, WR_SUCCESS);
+        }
+        else
+        {
+            /* No overshoot, just regular movement complete */
+            device->status.moving = 0;
+            NoteMoveFinished(lock, device, WR_SUCCESS);
+        }
 
-                if (SendCommand(device, cmd))
-                {
-                    device->status.moving = 1;
+        WR_DEBUG("MoveListener: Stopped for device %s", device->portName.c_str());
+    }
 
-                    /* Recursively call this function to handle the return movement */
-                    device->listenerRunning = false; /* Will be reset by StartMoveListener */
-                    StartMoveListener(device);
-                    return;
-                }
-                else
-                {
-                    WR_ERROR("Failed to send return movement command");
-                    device->overshooting = 0;
-                    device->status.moving = 0;
-                }
+    /* Background listener thread, waits for armed moves until the device is gone */
+    static void MoveListenerThreadFunc(std::shared_ptr<MoveListener> listener, std::weak_ptr<Device> owner)
+    {
+        unsigned int policyGeneration = ThreadPolicyGeneration(WR_THREAD_LISTENER);
+        ApplyThreadPolicy(WR_THREAD_LISTENER);
+
+        std::unique_lock<std::mutex> lock(listener->mutex);
+        while (true)
+        {
+            listener->wake.wait(lock, [&listener] { return listener->armed || listener->exit; });
+            if (listener->exit)
+            {
+                return;
             }
-            else if (device->overshooting == 2)
+            listener->armed = false;
+            lock.unlock();
+
+            /* The thread outlives WRSetThreadPolicy() calls, pick up a new policy per move */
+            unsigned int generation = ThreadPolicyGeneration(WR_THREAD_LISTENER);
+            if (generation != policyGeneration)
             {
-                /* Second phase complete */
-                device->overshooting = 0;
-                device->status.moving = 0;
-                WR_INFO("Backlash compensation complete, at target %.2f degrees", device->targetAngle);
+                policyGeneration = generation;
+                ApplyThreadPolicy(WR_THREAD_LISTENER, true);
             }
-            else
+
+            /* Hold the device only while a move is in flight */
+            if (std::shared_ptr<Device> device = owner.lock())
             {
-                /* No overshoot, just regular movement complete */
-                device->status.moving = 0;
+                ListenForMove(device);
             }
+
+            lock.lock();
         }
-        else
+    }
+
+    void PrepareMoveListener(const std::shared_ptr<Device> &device)
+    {
+        if (!device || device->listener)
         {
-            WR_DEBUG("MoveListener: Timeout reading from port");
-            device->listenerRunning = false;
             return;
         }
 
-        /* Mark listener as stopped before exiting */
-        device->listenerRunning = false;
-        WR_DEBUG("MoveListener: Stopped for device %s", device->portName.c_str());
+        device->listener = std::make_shared<MoveListener>();
+        std::thread listenerThread(MoveListenerThreadFunc, device->listener, std::weak_ptr<Device>(device));
+        listenerThread.detach(); /* Leaves on its own once the device is destroyed */
+        WR_DEBUG("PrepareMoveListener: Listener thread started");
     }
 
-    void StartMoveListener(std::shared_ptr<Device> device)
+    void StartMoveListener(const std::shared_ptr<Device> &device)
     {
         if (!device)
         {
             return;
         }
 
-        /* Stop any existing listener by setting the flag */
-        device->listenerRunning = false;
-
-        /* Small delay to let old thread exit if it's still running */
-        usleep(50000);
+        PrepareMoveListener(device);
 
-        /* Start new listener thread */
+        std::lock_guard<std::mutex> lock(device->listener->mutex);
         device->listenerRunning = true;
-        std::thread listenerThread(MoveListenerThreadFunc, device);
-        listenerThread.detach(); /* Detach immediately - let it run independently */
-        WR_DEBUG("StartMoveListener: Listener thread started");
+        device->listener->armed = true;
+        device->listener->wake.notify_one();
     }
 
-    void StopMoveListener(std::shared_ptr<Device> device)
+    void StopMoveListener(const std::shared_ptr<Device> &device)
     {
         if (!device)
         {
@@ -37,9 +37,83 @@ namespace WandererRotator
      * @param timeoutMs Timeout in milliseconds (default 3000ms)
      * @return true if command succeeded
      */
-    bool SendCommand(std::shared_ptr<Device> device, const char *command, int timeoutMs = 3000);
+    bool SendCommand(const std::shared_ptr<Device> &device, const char *command, int timeoutMs = 3000);
 
-    bool QueryStatus(std::shared_ptr<Device> device);
+    bool QueryStatus(const std::shared_ptr<Device> &device);
+
+    /**
+     * Record submission of a move phase for statistics, ETA and tracing.
+     * Call after the move command has been written.
+     *
+     * @param device Device that is moving
+     * @param steps Signed step count of this phase
+     * @param remainingSteps Absolute steps of phases still to follow (overshoot return)
+     */
+    void NoteMoveSubmitted(const std::shared_ptr<Device> &device, int steps, int remainingSteps);
+
+    /**
+     * Time left of the move in flight according to the move-time model.
+     *
+     * @param device Device to check
+     * @return Milliseconds, 0 if idle
+     */
+    int RemainingMoveMs(const Device &device);
+
+    /* Millidegrees in one revolution, the unit of Device::mechanicalAngle */
+    static constexpr int MILLIDEGREES_PER_REVOLUTION = 360000;
+
+    /**
+     * Convert an angle in degrees to motor steps, rounding to nearest.
+     *
+     * @param device Device providing steps per degree
+     * @param degrees Signed angle in degrees, clamped to one revolution
+     * @return Signed step count, 0 for a non-finite angle
+     */
+    int AngleToSteps(const std::shared_ptr<Device> &device, float degrees);
+
+    /**
+     * Convert millidegrees to motor steps, rounding half away from zero.
+     * Exact integer arithmetic, no floating point involved.
+     *
+     * @param device Device providing steps per degree
+     * @param milliDegrees Signed angle in millidegrees
+     * @return Signed step count
+     */
+    int MilliDegreesToSteps(const std::shared_ptr<Device> &device, int milliDegrees);
+
+    /**
+     * Shortest signed rotation from one position to another.
+     *
+     * @param fromMilliDegrees Current position in millidegrees
+     * @param toMilliDegrees Target position in millidegrees
+     * @return Delta in [-180000, 180000)
+     */
+    int ShortestDeltaMilliDegrees(int fromMilliDegrees, int toMilliDegrees);
+
+    /**
+     * Set status.position from mechanicalAngle, applying the correction table.
+     */
+    void UpdatePosition(const std::shared_ptr<Device> &device);
+
+    /**
+     * Mechanical position that lands on a true angle, applying the correction table.
+     *
+     * @param device Device providing the table
+     * @param degrees True angle in degrees, [0, 360)
+     * @return Mechanical position in millidegrees, [0, 360000)
+     */
+    int TargetMilliDegrees(const std::shared_ptr<Device> &device, float degrees);
+
+    /**
+     * Format a relative move command.
+     * Command format: 1000000 + steps
+     *
+     * @param steps Signed step count, positive = counterclockwise
+     * @param cmd Buffer receiving the command
+     * @param len Buffer length
+     * @return false if the step count cannot be encoded
+     */
+    bool MoveToCommand(int steps, char *cmd, int len);
 
     /**
      * Convert backlash value to command value.
@@ -58,24 +132,53 @@ namespace WandererRotator
      */
     const char *ReverseDirectionToCommand(int reverse);
 
+    /**
+     * Start the device's move listener thread if it has none yet.
+     * Called on open, so moves never create threads.
+     *
+     * @param device Device to listen on
+     */
+    void PrepareMoveListener(const std::shared_ptr<Device> &device);
+
     /**
      * Start listening for movement completion messages.
-     * Spawns a background thread that reads serial data until movement finishes.
-     * Should be called before triggering a move command.
+     * Wakes the device's listener thread, which reads serial data until movement finishes.
+     * Should be called right after triggering a move command.
      *
      * @param device Device to listen on
      */
-    void StartMoveListener(std::shared_ptr<Device> device);
+    void StartMoveListener(const std::shared_ptr<Device> &device);
 
     /**
      * Stop listening for movement completion messages.
-     * Terminates the background listener thread.
+     * The listener thread stays parked for the next move.
      * Should be called after movement finishes.
      *
      * @param device Device to stop listening on
      */
-    void StopMoveListener(std::shared_ptr<Device> device);
-    bool QueryHandshake(std::shared_ptr<Device> device);
+    void StopMoveListener(const std::shared_ptr<Device> &device);
+    bool QueryHandshake(const std::shared_ptr<Device> &device);
+
+    /**
+     * Result of a single link probe.
+     */
+    struct LinkProbe
+    {
+        long long roundTripUs = 0; /* Write until last response field */
+        int bytesReceived = 0;     /* All bytes read for this probe */
+        int errorBytes = 0;        /* Bytes in missing, truncated or malformed fields */
+    };
+
+    /**
+     * Send one status query (1500001) without touching device state and
+     * validate the shape of every response field.
+     *
+     * @param device Device to probe
+     * @param gapMs Pause before the query in milliseconds
+     * @param probe Receives timing and byte counts
+     * @return true if all fields arrived intact
+     */
+    bool QueryLinkProbe(const std::shared_ptr<Device> &device, int gapMs, LinkProbe *probe);
 
 } /* namespace WandererRotator */
 
@@ -27,6 +27,13 @@
 #include "WandererRotatorDevice.h"
 #include "WandererRotatorProtocol.h"
 #include "WandererRotatorSerialPort.h"
+#include "WandererRotatorTrace.h"
+#include "WandererRotatorMetrics.h"
+#include "WandererRotatorThreads.h"
+#include "WandererRotatorEvents.h"
+#include "WandererRotatorModels.h"
+#include "WandererRotatorProfiles.h"
+#include "WandererRotatorNotify.h"
 #include <map>
 #include <memory>
 #include <string>
@@ -44,10 +51,24 @@
 #include <sys/select.h>
 #include <dirent.h>
 #include <chrono>
+#include <algorithm>
+#include <vector>
 #include <libudev.h>
 
 #define SDK_VERSION "1.1.0"
 
+/* Inter-command gaps tried by WRRotatorLinkTest(), largest first */
+static const int LINK_TEST_GAPS_MS[] = {100, 50, 20, 10, 5, 2, 0};
+static const int LINK_TEST_GAP_COUNT = sizeof(LINK_TEST_GAPS_MS) / sizeof(LINK_TEST_GAPS_MS[0]);
+
+/* Clean queries needed before a gap counts as safe */
+static const int LINK_TEST_MIN_PER_RUNG = 10;
+
+/* Response timeout derived from a link test: a multiple of p99, within these bounds */
+static const int LINK_TIMEOUT_FACTOR = 4;
+static const int LINK_TIMEOUT_MIN_MS = 500;
+static const int LINK_TIMEOUT_MAX_MS = 3000;
+
 /* Import internal implementation for use in public C API */
 using namespace WandererRotator;
 
@@ -55,72 +76,239 @@ using namespace WandererRotator;
  * HELPER FUNCTIONS
  * ============================================================================ */
 
-static WR_ERROR_TYPE MoveInternal(std::shared_ptr<Device> device, float angle)
+/* Check whether the device's model understands a command (WR_MODEL_CMD_xxx).
+ * Before the first open the model is unknown and the port check reports the error.
+ */
+static bool ModelSupports(const std::shared_ptr<Device> &device, unsigned int command)
+{
+	return !device->traits || (device->traits->commands & command) == command;
+}
+
+/* Check whether a move is in flight. A move whose listener has stopped
+ * can't finish any more, e.g. after the port was closed under it, so its
+ * flag is cleared instead of blocking every call that needs an idle rotator.
+ */
+static bool IsMoving(const std::shared_ptr<Device> &device)
+{
+	if (device->status.moving && !device->listenerRunning)
+	{
+		WR_WARN("Clearing stale moving state of %s", device->portName.c_str());
+		device->overshooting = 0;
+		device->status.moving = 0;
+		device->positionValid = false;
+		NotifyChange(device, WR_NOTIFY_MOVING);
+	}
+	return device->status.moving != 0;
+}
+
+/* Check whether a move is too small to be worth sending */
+static bool IsInDeadband(const std::shared_ptr<Device> &device, int steps)
+{
+	return steps == 0 || abs(steps) < AngleToSteps(device, device->deadband);
+}
+
+/* Complete a move within the deadband without sending it */
+static WR_ERROR_TYPE SuppressMove(DeviceLock &lock, const std::shared_ptr<Device> &device, int steps)
+{
+	WR_DEBUG("Suppressing %d step move within deadband of %.4f degrees", steps, device->deadband);
+
+	WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_MOVE_SUPPRESSED);
+	entry.steps = steps;
+	device->history.Record(entry);
+
+	WR_EVENT event = MakeEvent(device, WR_EVENT_MOVE_SUPPRESSED);
+	event.steps = steps;
+
+	lock.Unlock();
+	EmitEvent(device, event);
+	return WR_SUCCESS;
+}
+
+/* Write a setting to the device and keep it in the history */
+static bool WriteSetting(const std::shared_ptr<Device> &device, const char *cmd)
+{
+	WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_CONFIG_WRITE);
+	bool sent = SendCommand(device, cmd);
+	entry.error = sent ? WR_SUCCESS : WR_ERROR_COMMUNICATION;
+	entry.elapsedMs = (int)((TraceNowUs() - entry.timestampUs) / 1000);
+	device->history.Record(entry);
+	return sent;
+}
+
+/* Pause before a move command so stale input can arrive and be flushed */
+static const int MOVE_DRAIN_MS = 50;
+
+/* Extra steps to move past the target for backlash overshoot, 0 if it does not apply */
+static int OvershootSteps(const std::shared_ptr<Device> &device, int steps)
 {
 	/* Check if overshoot applies for this movement
 	 * Overshoot is only applied in one direction based on overshotDirection flag
-	 * overshotDirection: 0 = apply overshoot for positive angles (CCW)
-	 *                    1 = apply overshoot for negative angles (CW)
+	 * overshotDirection: 0 = apply overshoot for positive moves (CCW)
+	 *                    1 = apply overshoot for negative moves (CW)
 	 */
-	int shouldApplyOvershoot = 0;
 	if (device->overshoot && device->overshootAngle > 0.0f)
 	{
-		if ((device->overshotDirection == 0 && angle > 0.0f) ||
-		    (device->overshotDirection == 1 && angle < 0.0f))
+		if ((device->overshotDirection == 0 && steps > 0) ||
+		    (device->overshotDirection == 1 && steps < 0))
 		{
-			shouldApplyOvershoot = 1;
+			return AngleToSteps(device, device->overshootAngle);
 		}
 	}
+	return 0;
+}
 
-	/* Phase 1: Move to the desired angle (+ overshoot if applicable) */
-	float moveAngle = angle;
-	if (shouldApplyOvershoot)
+/* Position in millidegrees where the device comes to rest once the
+ * move in flight, including a pending overshoot return, has finished.
+ */
+static int RestingMilliDegrees(const std::shared_ptr<Device> &device)
+{
+	if (!device->status.moving)
 	{
-		/* Add overshoot in the direction of movement */
-		if (angle > 0.0f)
-		{
-			moveAngle = angle + device->overshootAngle;
-		}
-		else
+		return device->mechanicalAngle;
+	}
+
+	long long steps = device->moveSteps + (device->overshooting == 1 ? device->overshootReturnSteps : 0);
+	long long milliDegrees = device->mechanicalAngle + steps * 1000 / device->stepsPerDegree;
+	return (int)(((milliDegrees % MILLIDEGREES_PER_REVOLUTION) + MILLIDEGREES_PER_REVOLUTION) % MILLIDEGREES_PER_REVOLUTION);
+}
+
+/* Poll interval while waiting for a move to finish */
+static const int MOVE_POLL_MS = 20;
+
+/* Relative move through the public API, returning once it has finished */
+static WR_ERROR_TYPE MoveAndWait(int id, const std::shared_ptr<Device> &device, float degrees)
+{
+	unsigned int finished = device->stats.movesFinished;
+
+	WR_ERROR_TYPE error = WRRotatorMove(id, degrees);
+	if (error != WR_SUCCESS)
+	{
+		return error;
+	}
+
+	/* Allow for both phases of an overshoot move */
+	int steps = AngleToSteps(device, degrees);
+	long long deadlineUs = TraceNowUs() + 2000LL * MoveTimeoutMs(device->traits, steps, device->stats.moveModel.PredictMs(steps));
+	while (device->stats.movesFinished == finished && device->status.moving)
+	{
+		if (TraceNowUs() > deadlineUs)
 		{
-			moveAngle = angle - device->overshootAngle;
+			return WR_ERROR_COMMUNICATION;
 		}
-		WR_INFO("Applying overshoot: moving to %.2f (target: %.2f, overshoot: %.2f)", 
-		        moveAngle, angle, device->overshootAngle);
+		usleep(MOVE_POLL_MS * 1000);
+	}
+
+	return device->stats.movesFinished != finished ? (WR_ERROR_TYPE)device->stats.lastMoveError.load() : WR_SUCCESS;
+}
+
+/* Predict the time WRRotatorMoveTo() takes from one position to another
+ * until the rotator has settled, mirroring what it sends. direction holds
+ * the sign of the previous motion (0 if unknown) and is updated, so the
+ * backlash the firmware takes up on reversals can be charged.
+ */
+static double EstimateMoveToMs(const std::shared_ptr<Device> &device, int fromMilliDegrees, int toMilliDegrees, int *direction)
+{
+	int steps = MilliDegreesToSteps(device, ShortestDeltaMilliDegrees(fromMilliDegrees, toMilliDegrees));
+	if (IsInDeadband(device, steps))
+	{
+		/* Completed from the cached position without serial traffic */
+		return 0.0;
+	}
+
+	const DeviceStats &stats = device->stats;
+	int backlashSteps = AngleToSteps(device, device->backlash / 10.0f);
+	int sign = steps > 0 ? 1 : -1;
+
+	/* Status query, then the move command */
+	double ms = device->queryGapMs + stats.latency.Percentile(50.0) + MOVE_DRAIN_MS + device->commandGapMs;
+
+	int overshootSteps = OvershootSteps(device, steps);
+	int travelSteps = abs(steps) + overshootSteps + (*direction == -sign ? backlashSteps : 0);
+	ms += stats.moveModel.PredictMs(travelSteps);
+	*direction = sign;
+
+	if (overshootSteps > 0)
+	{
+		/* Settle, then return against the direction of travel */
+		ms += device->traits->settleMs + device->commandGapMs;
+		ms += stats.moveModel.PredictMs(overshootSteps + backlashSteps);
+		*direction = -sign;
+	}
+
+	return ms + device->traits->settleMs;
+}
+
+/* Estimate each MoveTo of a sequence, caller holds the device lock and checked traits */
+static void EstimateMoveSequence(const std::shared_ptr<Device> &device, const float *angles, int count, int *ms)
+{
+	/* Start where the device will rest, after whatever is in flight */
+	double waitMs = RemainingMoveMs(*device);
+	int fromMilliDegrees = RestingMilliDegrees(device);
+	int direction = 0;
+	if (device->moveSteps != 0)
+	{
+		int lastSteps = (device->status.moving && device->overshooting == 1) ? device->overshootReturnSteps : device->moveSteps;
+		direction = lastSteps > 0 ? 1 : -1;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		int toMilliDegrees = TargetMilliDegrees(device, angles[i]);
+		ms[i] = (int)lround(waitMs + EstimateMoveToMs(device, fromMilliDegrees, toMilliDegrees, &direction));
+		fromMilliDegrees = toMilliDegrees;
+		waitMs = 0.0;
+	}
+}
+
+static WR_ERROR_TYPE MoveInternal(const std::shared_ptr<Device> &device, int steps)
+{
+	int overshootSteps = OvershootSteps(device, steps);
+
+	/* Phase 1: Move by the desired steps (+ overshoot if applicable) */
+	device->requestedSteps = steps;
+	int moveSteps = steps;
+	if (overshootSteps > 0)
+	{
+		/* Add overshoot in the direction of movement */
+		moveSteps = (steps > 0) ? steps + overshootSteps : steps - overshootSteps;
+		WR_INFO("Applying overshoot: moving %d steps (target: %d, overshoot: %d)",
+		        moveSteps, steps, overshootSteps);
 
 		/* Mark that we're in overshoot mode - waiting for first phase to complete */
 		device->overshooting = 1;
-		device->targetAngle = angle;
+		device->overshootReturnSteps = (steps > 0) ? -overshootSteps : overshootSteps;
 	}
 	else
 	{
 		/* Ensure overshoot flag is cleared if not applying */
 		device->overshooting = 0;
+		device->overshootReturnSteps = 0;
 	}
 
-	/* Relative movement by angle in degrees
-	 * Positive angle = counterclockwise
-	 * Negative angle = clockwise
-	 * Command: 1000000 + (angle * stepsPerDegree)
-	 */
-	int command_value = 1000000 + (int)(moveAngle * device->stepsPerDegree);
-	char cmd[8];
-	snprintf(cmd, sizeof(cmd), "%d", command_value);
+	char cmd[16];
+	if (!MoveToCommand(moveSteps, cmd, sizeof(cmd)))
+	{
+		device->overshooting = 0;
+		return WR_ERROR_INVALID_PARAMETER;
+	}
 
-	WR_DEBUG("MoveInternal: angle=%.2f, command=%s", moveAngle, cmd);
+	WR_DEBUG("MoveInternal: steps=%d, command=%s", moveSteps, cmd);
 
 	/* Drain any leftover data in the buffer before sending move command */
-	usleep(50000);
-	tcflush(device->port->GetFD(), TCIFLUSH); /* Flush input buffer */
+	usleep(MOVE_DRAIN_MS * 1000);
+	device->port->FlushInput();
 
 	if (!SendCommand(device, cmd))
 	{
 		device->overshooting = 0;
+		device->stats.lastMoveError = WR_ERROR_COMMUNICATION;
 		return WR_ERROR_COMMUNICATION;
 	}
 
 	/* Mark device as moving - status will be updated when response arrives */
 	device->status.moving = 1;
+	NoteMoveSubmitted(device, moveSteps, overshootSteps);
+	NotifyChange(device, WR_NOTIFY_MOVING);
 
 	/* Listener will get the rotation feedback */
 	StartMoveListener(device);
@@ -128,6 +316,133 @@ static WR_ERROR_TYPE MoveInternal(std::shared_ptr<Device> device, float angle)
 	return WR_SUCCESS;
 }
 
+/* Start an absolute move, caller holds the device lock (released if the move is suppressed).
+ * issued, if given, tells whether a move command was actually sent.
+ */
+static WR_ERROR_TYPE MoveToLocked(DeviceLock &lock, const std::shared_ptr<Device> &device, float angle, bool *issued = nullptr)
+{
+	if (issued)
+	{
+		*issued = false;
+	}
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	/* Absolute positioning in millidegrees, the device's own resolution.
+	 * Calculate relative movement needed from current position along the
+	 * shortest path, in [-180000, 180000).
+	 */
+	int targetMilliDegrees = TargetMilliDegrees(device, angle);
+
+	/* The cached position is exact while idle and read back since the last
+	 * move, so a target inside the deadband can be completed without
+	 * talking to the device at all.
+	 */
+	if (!device->status.moving && device->positionValid)
+	{
+		int cachedSteps = MilliDegreesToSteps(device, ShortestDeltaMilliDegrees(device->mechanicalAngle, targetMilliDegrees));
+		if (IsInDeadband(device, cachedSteps))
+		{
+			return SuppressMove(lock, device, cachedSteps);
+		}
+	}
+
+	// Fetch current position
+	if (!QueryStatus(device))
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	int deltaMilliDegrees = ShortestDeltaMilliDegrees(device->mechanicalAngle, targetMilliDegrees);
+	int steps = MilliDegreesToSteps(device, deltaMilliDegrees);
+
+	// Skip moves that round to zero steps or fall within the deadband
+	if (IsInDeadband(device, steps))
+	{
+		return SuppressMove(lock, device, steps);
+	}
+
+	WR_DEBUG("Moving from %d by %d mdeg (%d steps) to %d mdeg", device->mechanicalAngle,
+	         deltaMilliDegrees, steps, targetMilliDegrees);
+
+	WR_ERROR_TYPE error = MoveInternal(device, steps);
+	if (issued)
+	{
+		*issued = error == WR_SUCCESS;
+	}
+	return error;
+}
+
+/* Check whether a tty answers the rotator handshake */
+static bool ProbePort(const char *deviceNode)
+{
+	/* Probing a port another process is talking to would garble both
+	 * conversations and wait out a timeout, so skip it right away.
+	 */
+	int ownerPid = SerialPort::FindOwnerPid(deviceNode);
+	if (ownerPid)
+	{
+		WR_INFO("Skipping %s, in use by pid %d", deviceNode, ownerPid);
+		return false;
+	}
+
+	WR_DEBUG("Trying to open device: %s", deviceNode);
+
+	auto port = std::make_shared<SerialPort>();
+	if (!port->Open(deviceNode))
+	{
+		WR_DEBUG("Failed to open port %s%s", deviceNode, port->IsBusy() ? " (busy)" : "");
+		return false;
+	}
+
+	WR_DEBUG("Port opened, flushing and sending command...");
+
+	auto tempDevice = std::make_shared<Device>();
+	tempDevice->port = port;
+	tempDevice->portName = deviceNode;
+
+	bool found = QueryHandshake(tempDevice);
+	if (found)
+	{
+		WR_DEBUG("Valid Wanderer Rotator found!");
+	}
+	else
+	{
+		WR_DEBUG("No response from device");
+	}
+
+	/* Close either way, a rotator is reopened in WRRotatorOpen */
+	port->Close();
+	return found;
+}
+
+/* Device of a registry generation using a port, nullptr if none */
+static std::shared_ptr<Device> FindDeviceByPort(const DeviceTable &devices, const char *portName)
+{
+	for (const auto &device : devices.Slots())
+	{
+		if (device && device->portName == portName)
+		{
+			return device;
+		}
+	}
+	return nullptr;
+}
+
+/* Lowest id used by neither the published nor the next registry generation */
+static int NextFreeId(const DeviceTable &current, const DeviceTable &next)
+{
+	int id = 0;
+	while (current.Contains(id) || next.Contains(id))
+	{
+		id++;
+	}
+	return id;
+}
+
 /* ============================================================================
  * PUBLIC SDK API IMPLEMENTATION
  * ============================================================================ */
@@ -144,16 +459,70 @@ WRAPI WR_ERROR_TYPE WRGetSDKVersion(char *version)
 	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids)
+WRAPI WR_ERROR_TYPE WRRegisterModel(const WR_MODEL_TRAITS *traits)
 {
-	if (!number || !ids)
+	if (!traits)
 	{
 		return WR_ERROR_NULL_POINTER;
 	}
 
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	if (!IsValidModel(*traits))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!RegisterModel(*traits))
+	{
+		WR_ERROR("WRRegisterModel: Registry full (%d models)", MAX_REGISTERED_MODELS);
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRSetTraceFile(const char *path)
+{
+	/* Make sure a later first use does not re-open WR_TRACE_FILE over this choice */
+	TraceEnabled();
+
+	if (!TraceOpen(path))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return WR_SUCCESS;
+}
+
+/* Copy up to capacity IDs out; fails if they did not all fit, unless the caller only counts */
+static WR_ERROR_TYPE CopyIds(const std::vector<int> &found, int *number, int *ids, int capacity)
+{
+	*number = (int)found.size();
+	if (!ids && capacity == 0)
+	{
+		return WR_SUCCESS;
+	}
+
+	int copied = std::min(*number, capacity);
+	if (ids && copied > 0)
+	{
+		memcpy(ids, found.data(), copied * sizeof(int));
+	}
+
+	/* Caller sizes an array from *number, after a scan via WRRotatorListDevices() */
+	return copied < *number ? WR_ERROR_INVALID_PARAMETER : WR_SUCCESS;
+}
 
-	int count = 0;
+/* Enumerate and probe ports, publish the next registry generation and
+ * collect the IDs of the rotators found.
+ */
+static WR_ERROR_TYPE ScanDevices(std::vector<int> &foundIds)
+{
+	/* Scans only wait for each other. Device calls keep using the published
+	 * generation while the next one is built.
+	 */
+	std::lock_guard<std::mutex> scanLock(g_registryMutex);
+	std::shared_ptr<const DeviceTable> current = SnapshotDevices();
+	auto next = std::make_shared<DeviceTable>();
 
 	/* Create udev context */
 	struct udev *udev = udev_new();
@@ -177,14 +546,9 @@ WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids)
 	struct udev_list_entry *devices = udev_enumerate_get_list_entry(enumerate);
 	struct udev_list_entry *entry;
 
-	char response[64];
-
 	/* Iterate through all tty devices */
 	udev_list_entry_foreach(entry, devices)
 	{
-		if (count >= WR_MAX_NUM)
-			break;
-
 		const char *path = udev_list_entry_get_name(entry);
 		struct udev_device *device = udev_device_new_from_syspath(udev, path);
 		if (!device)
@@ -228,65 +592,150 @@ WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids)
 			continue;
 		}
 
-		WR_DEBUG("Trying to open device: %s", deviceNode);
-
-		/* Try to open the port */
-		auto port = std::make_shared<SerialPort>();
-		if (port->Open(deviceNode))
+		/* A known device keeps its object and id. Its port is never probed
+		 * while a handle is open or a call is in progress on it. The lock is
+		 * dropped before probing, which can take a response timeout; an open
+		 * racing with the probe is refused by the port's exclusive lock.
+		 */
+		std::shared_ptr<Device> known = FindDeviceByPort(*current, deviceNode);
+		bool found;
+		if (known)
 		{
-			WR_DEBUG("Port opened, flushing and sending command...");
-
-			auto tempDevice = std::make_shared<Device>();
-			tempDevice->port = port;
-			tempDevice->portName = deviceNode;
-
-			if (QueryHandshake(tempDevice))
-			{
-				WR_DEBUG("Valid Wanderer Rotator found!");
-				/* Valid Wanderer Rotator found - close port, will be reopened in WRRotatorOpen */
-				port->Close();
-				int id = count;
-				g_devices[id] = tempDevice;
-				ids[count] = id;
-				count++;
-			}
-			else
+			bool inUse;
 			{
-				WR_DEBUG("No response from device");
-				/* Not a valid Wanderer Rotator, close port */
-				port->Close();
+				std::unique_lock<std::mutex> busy(known->apiMutex, std::try_to_lock);
+				inUse = !busy.owns_lock() || (known->port && known->port->IsOpen());
 			}
+			found = inUse || ProbePort(deviceNode);
+		}
+		else if (ProbePort(deviceNode))
+		{
+			known = std::make_shared<Device>();
+			known->portName = deviceNode;
+			known->id = NextFreeId(*current, *next);
+			found = true;
 		}
 		else
 		{
-			WR_DEBUG("Failed to open port %s", deviceNode);
+			found = false;
+		}
+
+		if (found)
+		{
+			next->Set(known->id, known);
+			foundIds.push_back(known->id);
 		}
 
 		udev_device_unref(device);
 	}
 
+	/* Devices in use that were not enumerated (e.g. unplugged) keep their handles */
+	for (const auto &existing : current->Slots())
+	{
+		if (!existing || next->Contains(existing->id))
+		{
+			continue;
+		}
+
+		std::unique_lock<std::mutex> busy(existing->apiMutex, std::try_to_lock);
+		if (!busy.owns_lock() || (existing->port && existing->port->IsOpen()))
+		{
+			next->Set(existing->id, existing);
+		}
+	}
+
+	/* Publish the new generation; calls holding the old one finish on it */
+	PublishDevices(next);
+
 	/* Clean up udev resources */
 	udev_enumerate_unref(enumerate);
 	udev_unref(udev);
 
-	*number = count;
 	return WR_SUCCESS;
 }
 
+WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids)
+{
+	if (!number || !ids)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	std::vector<int> found;
+	WR_ERROR_TYPE result = ScanDevices(found);
+	if (result != WR_SUCCESS)
+	{
+		return result;
+	}
+
+	/* Fixed WR_MAX_NUM array; more devices are registered but not reported */
+	CopyIds(found, number, ids, WR_MAX_NUM);
+	*number = std::min(*number, WR_MAX_NUM);
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorScanEx(int *number, int *ids, int capacity)
+{
+	if (!number || (!ids && capacity > 0))
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (capacity < 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	std::vector<int> found;
+	WR_ERROR_TYPE result = ScanDevices(found);
+	if (result != WR_SUCCESS)
+	{
+		return result;
+	}
+
+	return CopyIds(found, number, ids, capacity);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorListDevices(int *number, int *ids, int capacity)
+{
+	if (!number || (!ids && capacity > 0))
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (capacity < 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	std::vector<int> known;
+	std::shared_ptr<const DeviceTable> devices = SnapshotDevices();
+	known.reserve(devices->Count());
+	for (const auto &device : devices->Slots())
+	{
+		if (device)
+		{
+			known.push_back(device->id);
+		}
+	}
+
+	return CopyIds(known, number, ids, capacity);
+}
+
 WRAPI WR_ERROR_TYPE WRRotatorOpen(int id)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
 	WR_DEBUG("WRRotatorOpen: Opening device id=%d", id);
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		WR_ERROR("WRRotatorOpen: Device id=%d not found", id);
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 	WR_DEBUG("WRRotatorOpen: Found device, portName=%s", device->portName.c_str());
+	WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_OPEN);
 
 	/* Create a new SerialPort instance and open it */
 	if (!device->port)
@@ -296,8 +745,13 @@ WRAPI WR_ERROR_TYPE WRRotatorOpen(int id)
 	}
 
 	WR_DEBUG("WRRotatorOpen: Attempting to open port %s", device->portName.c_str());
-	if (!device->port->Open(device->portName.c_str()))
+	if (!device->port->Open(device->portName.c_str(), device->serialProfile))
 	{
+		if (device->port->IsBusy())
+		{
+			WR_ERROR("WRRotatorOpen: Port is in use by pid %d", device->port->GetOwnerPid());
+			return WR_ERROR_PORT_BUSY;
+		}
 		WR_ERROR("WRRotatorOpen: Failed to open port");
 		return WR_ERROR_COMMUNICATION;
 	}
@@ -312,28 +766,42 @@ WRAPI WR_ERROR_TYPE WRRotatorOpen(int id)
 		return WR_ERROR_COMMUNICATION;
 	}
 
+	/* Resolve the model afresh, so models registered since the last open apply */
+	device->traits = nullptr;
+
 	if (!QueryStatus(device))
 	{
 		WR_ERROR("WRRotatorOpen: Querying for status failed");
 		device->port->Close();
-		return WR_ERROR_COMMUNICATION;
+		/* A complete answer from a model without traits is not a link problem */
+		return (!device->modelType.empty() && !device->traits) ? WR_ERROR_NOT_SUPPORTED : WR_ERROR_COMMUNICATION;
+	}
+
+	PrepareMoveListener(device);
+
+	if (device->stats.opens++ > 0)
+	{
+		device->stats.reconnects++;
 	}
 
+	entry.position = device->status.position;
+	entry.steps = device->stats.reconnects;
+	entry.elapsedMs = (int)((TraceNowUs() - entry.timestampUs) / 1000);
+	device->history.Record(entry);
+
 	WR_INFO("[OK] Rotator opened");
 	return WR_SUCCESS;
 }
 
 WRAPI WR_ERROR_TYPE WRRotatorClose(int id)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
-
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 
 	/* Stop any running listener thread first */
 	StopMoveListener(device);
@@ -354,15 +822,13 @@ WRAPI WR_ERROR_TYPE WRRotatorGetConfig(int id, WR_ROTATOR_CONFIG *config)
 		return WR_ERROR_NULL_POINTER;
 	}
 
-	std::lock_guard<std::mutex> lock(g_globalMutex);
-
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 	config->reverseDirection = device->rotator.reverseDirection;
 	config->backlash = device->backlash / 10.0f; /* Convert from internal format */
 	config->overshoot = device->overshoot;
@@ -379,21 +845,25 @@ WRAPI WR_ERROR_TYPE WRRotatorSetConfig(int id, WR_ROTATOR_CONFIG *config)
 		return WR_ERROR_NULL_POINTER;
 	}
 
-	std::lock_guard<std::mutex> lock(g_globalMutex);
-
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
+
+	if (((config->mask & MASK_ROTATOR_REVERSE_DIRECTION) && !ModelSupports(device, WR_MODEL_CMD_REVERSE)) ||
+	    ((config->mask & MASK_ROTATOR_BACKLASH) && !ModelSupports(device, WR_MODEL_CMD_BACKLASH)))
+	{
+		return WR_ERROR_NOT_SUPPORTED;
+	}
 
 	if (config->mask & MASK_ROTATOR_REVERSE_DIRECTION)
 	{
 		/* Send reverse direction command: 1700000 or 1700001 */
 		const char *cmd = ReverseDirectionToCommand(config->reverseDirection);
-		if (!SendCommand(device, cmd))
+		if (!WriteSetting(device, cmd))
 			return WR_ERROR_COMMUNICATION;
 
 		device->rotator.reverseDirection = config->reverseDirection;
@@ -412,12 +882,12 @@ WRAPI WR_ERROR_TYPE WRRotatorSetConfig(int id, WR_ROTATOR_CONFIG *config)
 		char cmd[32];
 		snprintf(cmd, sizeof(cmd), "%d\n", command_value);
 
-		if (!SendCommand(device, cmd))
+		if (!WriteSetting(device, cmd))
 		{
 			return WR_ERROR_COMMUNICATION;
 		}
 
-		device->backlash = (int)(config->backlash * 10.0f);
+		device->backlash = (int)lroundf(config->backlash * 10.0f);
 	}
 
 	if (config->mask & MASK_ROTATOR_OVERSHOOT)
@@ -448,200 +918,1283 @@ WRAPI WR_ERROR_TYPE WRRotatorSetConfig(int id, WR_ROTATOR_CONFIG *config)
 		WR_DEBUG("Set backlash overshoot direction to %d", device->overshotDirection);
 	}
 
+	NotifyChange(device, WR_NOTIFY_CONFIG);
 	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorGetStatus(int id, WR_ROTATOR_STATUS *status)
+WRAPI WR_ERROR_TYPE WRRotatorSetDeadband(int id, float degrees)
 {
-	if (!status)
+	if (!(degrees >= 0.0f && degrees < 180.0f))
 	{
-		return WR_ERROR_NULL_POINTER;
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
 	}
 
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	DeviceLock lock(device, __func__);
+
+	device->deadband = degrees;
+	NotifyChange(device, WR_NOTIFY_CONFIG);
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorGetDeadband(int id, float *degrees)
+{
+	if (!degrees)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 
-	/* If currently moving, hardware does not support fetching latest status */
+	*degrees = device->deadband;
+	return WR_SUCCESS;
+}
 
-	status->position = device->status.position;
-	status->moving = device->status.moving;
-	status->stepsPerRevolution = device->status.stepsPerRevolution;
-	status->stepSize = device->status.stepSize;
+WRAPI WR_ERROR_TYPE WRRotatorSetCorrectionTable(int id, const float *angles, const float *errors, int count)
+{
+	std::shared_ptr<CorrectionTable> table;
+	if (count != 0)
+	{
+		if (!angles || !errors)
+		{
+			return WR_ERROR_NULL_POINTER;
+		}
+
+		table = std::make_shared<CorrectionTable>();
+		if (!table->Build(angles, errors, count))
+		{
+			return WR_ERROR_INVALID_PARAMETER;
+		}
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
 
+	DeviceLock lock(device, __func__);
+	std::atomic_store(&device->correction, std::shared_ptr<const CorrectionTable>(table));
+	UpdatePosition(device);
+	NotifyChange(device, WR_NOTIFY_CONFIG);
+
+	WR_DEBUG("Correction table set with %d points", count);
 	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorGetVersion(int id, WR_VERSION *version)
+WRAPI WR_ERROR_TYPE WRRotatorLoadCorrectionTable(int id, const char *path)
 {
-	if (!version)
+	if (!path)
 	{
 		return WR_ERROR_NULL_POINTER;
 	}
 
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	std::vector<float> angles, errors;
+	if (!ReadCorrectionFile(path, angles, errors) || angles.empty())
+	{
+		WR_ERROR("WRRotatorLoadCorrectionTable: Cannot read calibration points from %s", path);
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return WRRotatorSetCorrectionTable(id, angles.data(), errors.data(), (int)angles.size());
+}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+WRAPI WR_ERROR_TYPE WRRotatorSetEventCallback(int id, WR_EVENT_CALLBACK callback, void *context)
+{
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
-	version->firmware = device->firmwareVersion;
-	strncpy(version->model, device->modelType.c_str(), sizeof(version->model) - 1);
-	version->model[sizeof(version->model) - 1] = '\0';
+	DeviceLock lock(device, __func__);
 
+	SetEventCallback(device, callback, context);
 	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorFindHome(int id)
+WRAPI WR_ERROR_TYPE WRRotatorGetHistory(int id, WR_HISTORY_ENTRY *entries, int capacity, int *count)
 {
-	return WRRotatorMoveTo(id, 0.0f);
+	if (!entries || !count)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (capacity < 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	/* No device lock: usable while a call on the device is stuck */
+	*count = device->history.Read(entries, capacity);
+	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorSyncPosition(int id, float angle)
+WRAPI WR_ERROR_TYPE WRRotatorSubscribe(int id, const WR_SUBSCRIPTION *subscription,
+									   WR_NOTIFY_CALLBACK callback, void *context, int *handle)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	if (!subscription || !callback || !handle)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!subscription->mask || (subscription->mask & ~(unsigned int)(WR_NOTIFY_POSITION | WR_NOTIFY_MOVING |
+																	  WR_NOTIFY_ERROR | WR_NOTIFY_CONFIG)) ||
+		!(subscription->positionThreshold >= 0.0f) || !(subscription->maxRate >= 0.0f))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 
-	if (!device->port || !device->port->IsOpen())
+	*handle = Subscribe(device, *subscription, callback, context);
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRUnsubscribe(int handle)
+{
+	if (!Unsubscribe(handle))
 	{
-		return WR_ERROR_COMMUNICATION;
+		return WR_ERROR_INVALID_PARAMETER;
 	}
 
-	// So far, we only support setting to zero
-	if (angle != 0.0f)
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRSaveProfile(const char *name, const WR_PROFILE *profile)
+{
+	if (!name || !profile)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!IsValidProfile(*profile) || !SaveProfile(name, *profile))
 	{
 		return WR_ERROR_INVALID_PARAMETER;
 	}
 
-	if (angle < 0.0f || angle >= 360.0f)
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRGetProfile(const char *name, WR_PROFILE *profile)
+{
+	if (!name || !profile)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!FindProfile(name, profile))
 	{
 		return WR_ERROR_INVALID_PARAMETER;
 	}
 
-	/* Set the current mechanical position as zero (home)
-	 * Command: 1500002
-	 */
-	if (!SendCommand(device, "1500002"))
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRDeleteProfile(const char *name)
+{
+	if (!name)
 	{
-		return WR_ERROR_COMMUNICATION;
+		return WR_ERROR_NULL_POINTER;
 	}
 
-	/* Update the status position to reflect the sync */
-	device->status.position = angle;
+	if (!DeleteProfile(name))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
 
 	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorMove(int id, float angle)
+WRAPI WR_ERROR_TYPE WRRotatorSaveProfile(int id, const char *name)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	if (!name)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 
-	if (!device->port || !device->port->IsOpen())
+	WR_PROFILE profile;
+	memset(&profile, 0, sizeof(profile));
+	profile.config.mask = MASK_ROTATOR_ALL;
+	profile.config.reverseDirection = device->rotator.reverseDirection;
+	profile.config.backlash = device->backlash / 10.0f;
+	profile.config.overshoot = device->overshoot;
+	profile.config.overshootAngle = device->overshootAngle;
+	profile.config.overshotDirection = device->overshotDirection;
+	profile.deadband = device->deadband;
+
+	if (!SaveProfile(name, profile))
 	{
-		return WR_ERROR_COMMUNICATION;
+		return WR_ERROR_INVALID_PARAMETER;
 	}
 
-	return MoveInternal(device, angle);
+	device->profileName = name;
+	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorMoveTo(int id, float angle)
+WRAPI WR_ERROR_TYPE WRRotatorApplyProfile(int id, const char *name)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	if (!name)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	WR_PROFILE profile;
+	if (!FindProfile(name, &profile))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	/* Held throughout, so no move on this device can start while the profile is half applied */
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
 
-	if (!device->port || !device->port->IsOpen())
+	if (IsMoving(device))
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	/* Only write device fields that differ from what the device reported */
+	const WR_ROTATOR_CONFIG &config = profile.config;
+	int backlash = (int)lroundf(config.backlash * 10.0f);
+	bool writeReverse = (config.reverseDirection != 0) != (device->reverseDirection != 0);
+	bool writeBacklash = backlash != device->backlash;
+
+	if ((writeReverse && !ModelSupports(device, WR_MODEL_CMD_REVERSE)) ||
+	    (writeBacklash && !ModelSupports(device, WR_MODEL_CMD_BACKLASH)))
+	{
+		return WR_ERROR_NOT_SUPPORTED;
+	}
+
+	if (writeReverse && !WriteSetting(device, ReverseDirectionToCommand(config.reverseDirection)))
 	{
 		return WR_ERROR_COMMUNICATION;
 	}
 
-	if (angle < 0.0f || angle >= 360.0f)
+	if (writeBacklash)
+	{
+		char cmd[32];
+		snprintf(cmd, sizeof(cmd), "%d\n", BacklashToCommand(config.backlash));
+		if (!WriteSetting(device, cmd))
+		{
+			/* Don't leave the device half switched */
+			if (writeReverse)
+			{
+				WriteSetting(device, ReverseDirectionToCommand(device->reverseDirection));
+			}
+			return WR_ERROR_COMMUNICATION;
+		}
+	}
+
+	/* The device took everything, commit the SDK side */
+	device->rotator.reverseDirection = config.reverseDirection != 0 ? 1 : 0;
+	device->reverseDirection = config.reverseDirection != 0 ? 1 : 0;
+	device->backlash = backlash;
+	device->overshoot = config.overshoot != 0;
+	device->overshootAngle = config.overshootAngle;
+	device->overshotDirection = config.overshotDirection != 0;
+	device->deadband = profile.deadband;
+
+	/* A different optical train invalidates what closed-loop positioning learned */
+	if (device->profileName != name)
+	{
+		device->sky.Reset();
+		device->profileName = name;
+	}
+
+	NotifyChange(device, WR_NOTIFY_CONFIG);
+
+	WR_DEBUG("Applied profile '%s' (reverse %s, backlash %s)", name,
+	         writeReverse ? "written" : "unchanged", writeBacklash ? "written" : "unchanged");
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorGetActiveProfile(int id, char *name)
+{
+	if (!name)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	strncpy(name, device->profileName.c_str(), WR_PROFILE_NAME_LEN - 1);
+	name[WR_PROFILE_NAME_LEN - 1] = '\0';
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorGetSerialProfile(int id, WR_SERIAL_PROFILE *profile)
+{
+	if (!profile)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	const SerialProfile &settings = device->serialProfile;
+	profile->baudRate = settings.baudRate;
+	profile->lowLatency = settings.lowLatency;
+	profile->drainOnWrite = settings.drainOnWrite;
+	profile->txQueueLimit = settings.txQueueLimit;
+	profile->exclusive = settings.exclusive;
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorSetSerialProfile(int id, const WR_SERIAL_PROFILE *profile)
+{
+	if (!profile)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!SerialPort::IsSupportedBaudRate(profile->baudRate) || profile->txQueueLimit < 0)
 	{
 		return WR_ERROR_INVALID_PARAMETER;
 	}
 
-	// Fetch current position
-	if (!QueryStatus(device))
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	/* Changing the line under an in-flight move would garble its feedback */
+	if (IsMoving(device))
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	SerialProfile settings;
+	settings.baudRate = profile->baudRate;
+	settings.lowLatency = profile->lowLatency != 0;
+	settings.drainOnWrite = profile->drainOnWrite != 0;
+	settings.txQueueLimit = profile->txQueueLimit;
+	settings.exclusive = profile->exclusive != 0;
+
+	if (device->port && device->port->IsOpen() && !device->port->ApplyProfile(settings))
 	{
+		/* Claiming exclusive ownership of a port someone else also has open */
+		if (settings.exclusive && !device->serialProfile.exclusive && SerialPort::FindOwnerPid(device->portName.c_str()))
+		{
+			return WR_ERROR_PORT_BUSY;
+		}
 		return WR_ERROR_COMMUNICATION;
 	}
 
-	float currentAngle = (float)device->mechanicalAngle / 1000.0f;
+	device->serialProfile = settings;
+	NotifyChange(device, WR_NOTIFY_CONFIG);
+	return WR_SUCCESS;
+}
 
-	/* Absolute positioning
-	 * Calculate relative movement needed from current position
-	 */
-	float delta = angle - currentAngle;
+WRAPI WR_ERROR_TYPE WRRotatorGetPortOwner(int id, int *pid)
+{
+	if (!pid)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	*pid = SerialPort::FindOwnerPid(device->portName.c_str());
+	return WR_SUCCESS;
+}
 
-	/* Normalize delta to shortest path */
-	delta = fmodf(delta + 180.0f, 360.0f);
-	delta = (delta < 0.0f) ? delta + 180.0f : delta - 180.0f;
+WRAPI WR_ERROR_TYPE WRRotatorGetStatus(int id, WR_ROTATOR_STATUS *status)
+{
+	if (!status)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
 
-	// Skip 0 delta
-	if (delta == 0.0f)
+	auto device = FindDevice(id);
+	if (!device)
 	{
-		return WR_SUCCESS;
+		return WR_ERROR_INVALID_ID;
 	}
 
-	WR_DEBUG("Moving from %f by %f to %f\n", currentAngle, delta, angle);
+	DeviceLock lock(device, __func__);
+
+	/* If currently moving, hardware does not support fetching latest status */
+
+	status->position = device->status.position;
+	status->moving = device->status.moving;
+	status->stepsPerRevolution = device->status.stepsPerRevolution;
+	status->stepSize = device->status.stepSize;
 
-	return MoveInternal(device, delta);
+	return WR_SUCCESS;
 }
 
-WRAPI WR_ERROR_TYPE WRRotatorStopMove(int id)
+WRAPI WR_ERROR_TYPE WRRotatorGetStats(int id, WR_ROTATOR_STATS *stats)
 {
-	std::lock_guard<std::mutex> lock(g_globalMutex);
+	if (!stats)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
 
-	auto it = g_devices.find(id);
-	if (it == g_devices.end())
+	auto device = FindDevice(id);
+	if (!device)
 	{
 		return WR_ERROR_INVALID_ID;
 	}
 
-	auto device = it->second;
+	DeviceLock lock(device, __func__);
+	const DeviceStats &deviceStats = device->stats;
 
-	if (!device->port || !device->port->IsOpen())
+	stats->position = device->status.position;
+	stats->moving = device->status.moving;
+	stats->phase = device->overshooting;
+
+	stats->etaMs = RemainingMoveMs(*device);
+
+	stats->lastMoveError = deviceStats.lastMoveError;
+	stats->latencyP50Ms = deviceStats.latency.Percentile(50.0);
+	stats->latencyP90Ms = deviceStats.latency.Percentile(90.0);
+	stats->latencyP99Ms = deviceStats.latency.Percentile(99.0);
+	stats->queries = (unsigned int)deviceStats.latency.Count();
+	stats->commands = deviceStats.commands;
+	stats->moves = deviceStats.moves;
+	stats->timeouts = deviceStats.timeouts;
+	stats->parseErrors = deviceStats.parseErrors;
+	stats->reconnects = deviceStats.reconnects;
+	stats->stepRate = deviceStats.moveModel.StepRate();
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorGetVersion(int id, WR_VERSION *version)
+{
+	if (!version)
 	{
-		return WR_ERROR_COMMUNICATION;
+		return WR_ERROR_NULL_POINTER;
 	}
 
-	/* Send stop command */
-	if (!SendCommand(device, "stop"))
+	auto device = FindDevice(id);
+	if (!device)
 	{
-		return WR_ERROR_COMMUNICATION;
+		return WR_ERROR_INVALID_ID;
 	}
 
-	device->status.moving = 0;
+	DeviceLock lock(device, __func__);
+	version->firmware = device->firmwareVersion;
+	strncpy(version->model, device->modelType.c_str(), sizeof(version->model) - 1);
+	version->model[sizeof(version->model) - 1] = '\0';
 
 	return WR_SUCCESS;
-}
\ No newline at end of file
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorGetModelTraits(int id, WR_MODEL_TRAITS *traits)
+{
+	if (!traits)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	/* Resolved when the device is opened */
+	if (!device->traits)
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	*traits = *device->traits;
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorFindHome(int id)
+{
+	return WRRotatorMoveTo(id, 0.0f);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorSyncPosition(int id, float angle)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	// So far, we only support setting to zero
+	if (angle != 0.0f)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	if (angle < 0.0f || angle >= 360.0f)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!ModelSupports(device, WR_MODEL_CMD_SYNC))
+	{
+		return WR_ERROR_NOT_SUPPORTED;
+	}
+
+	/* Set the current mechanical position as zero (home)
+	 * Command: 1500002
+	 */
+	if (!WriteSetting(device, "1500002"))
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	/* Update the status position to reflect the sync */
+	device->mechanicalAngle = 0;
+	device->positionValid = true;
+	UpdatePosition(device);
+	NotifyChange(device, WR_NOTIFY_CONFIG);
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorMove(int id, float angle)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	if (!std::isfinite(angle))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	int steps = AngleToSteps(device, angle);
+	if (IsInDeadband(device, steps))
+	{
+		return SuppressMove(lock, device, steps);
+	}
+
+	return MoveInternal(device, steps);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorMoveSteps(int id, int steps)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	if (IsInDeadband(device, steps))
+	{
+		return SuppressMove(lock, device, steps);
+	}
+
+	return MoveInternal(device, steps);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorMoveTo(int id, float angle)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!(angle >= 0.0f && angle < 360.0f))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return MoveToLocked(lock, device, angle);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorSolveTo(int id, float skyAngle, float tolerance, int maxMoves,
+                                     WR_MEASURE_CALLBACK measure, void *context, WR_SOLVE_RESULT *result)
+{
+	if (!measure)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!(skyAngle >= 0.0f && skyAngle < 360.0f) || !(tolerance > 0.0f) || maxMoves < 1)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	std::shared_ptr<Device> device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	/* One solve at a time per device, they would fight over the sky model */
+	std::lock_guard<std::mutex> solveLock(device->solveMutex);
+
+	{
+		DeviceLock lock(device, __func__);
+
+		if (!device->port || !device->port->IsOpen())
+		{
+			return WR_ERROR_COMMUNICATION;
+		}
+
+		if (!device->traits || IsMoving(device))
+		{
+			return WR_ERROR_INVALID_STATE;
+		}
+	}
+
+	/* The device lock is only taken around the sky model and position:
+	 * moves go through the public API and the measurement may take as
+	 * long as an exposure.
+	 */
+	WR_SOLVE_RESULT solve;
+	memset(&solve, 0, sizeof(solve));
+	SkyModel &model = device->sky;
+
+	/* Measure the sky angle at the current position */
+	auto measureSky = [&](double *sky) -> bool
+	{
+		float measured;
+		solve.measurements++;
+		if (measure(id, &measured, context) != 0)
+		{
+			return false;
+		}
+		*sky = measured;
+		solve.skyAngle = measured;
+		return true;
+	};
+
+	WR_ERROR_TYPE error = WR_ERROR_NOT_CONVERGED;
+	double sky = 0.0;
+	bool measured = false;
+	bool anchored;
+
+	/* A model anchored by an earlier call predicts the sky angle, which
+	 * saves the initial exposure; the first measurement verifies it.
+	 */
+	{
+		DeviceLock lock(device, __func__);
+		anchored = model.Anchored();
+		if (anchored)
+		{
+			sky = model.PredictSky(device->status.position);
+		}
+	}
+
+	if (!anchored)
+	{
+		if (measureSky(&sky))
+		{
+			DeviceLock lock(device, __func__);
+			model.Anchor(device->status.position, sky);
+			measured = true;
+		}
+		else
+		{
+			error = WR_ERROR_INVALID_STATE;
+		}
+	}
+
+	while (error == WR_ERROR_NOT_CONVERGED)
+	{
+		double skyError = WrapDegrees(skyAngle - sky);
+		if (fabs(skyError) <= tolerance)
+		{
+			if (measured)
+			{
+				error = WR_SUCCESS;
+				break;
+			}
+
+			/* Predicted on target, confirm without moving */
+			if (!measureSky(&sky))
+			{
+				error = WR_ERROR_INVALID_STATE;
+				break;
+			}
+			DeviceLock lock(device, __func__);
+			model.Anchor(device->status.position, sky);
+			measured = true;
+			continue;
+		}
+
+		if (solve.moves >= maxMoves)
+		{
+			break;
+		}
+
+		double command;
+		float before;
+		bool inDeadband;
+		{
+			DeviceLock lock(device, __func__);
+			command = model.CommandFor(skyError);
+			inDeadband = IsInDeadband(device, AngleToSteps(device, command));
+			before = device->status.position;
+		}
+		if (inDeadband)
+		{
+			WR_INFO("SolveTo: correction of %.4f degrees is within the deadband", command);
+			break;
+		}
+
+		error = MoveAndWait(id, device, (float)command);
+		if (error != WR_SUCCESS)
+		{
+			break;
+		}
+		error = WR_ERROR_NOT_CONVERGED;
+		solve.moves++;
+
+		/* The position reported after the move covers all overshoot phases */
+		double achieved;
+		{
+			DeviceLock lock(device, __func__);
+			achieved = WrapDegrees(device->status.position - before);
+		}
+		double previousSky = sky;
+		if (!measureSky(&sky))
+		{
+			error = WR_ERROR_INVALID_STATE;
+			break;
+		}
+
+		DeviceLock lock(device, __func__);
+
+		/* Only a measured starting point tells how far the sky really turned */
+		if (measured)
+		{
+			model.AddMove(command, achieved, WrapDegrees(sky - previousSky));
+		}
+		model.Anchor(device->status.position, sky);
+		measured = true;
+
+		WR_DEBUG("SolveTo: commanded %.3f achieved %.3f sky %.3f gain %.3f efficiency %.3f",
+		         command, achieved, sky, model.SkyGain(), model.Efficiency());
+	}
+
+	solve.error = (float)WrapDegrees(skyAngle - solve.skyAngle);
+	{
+		DeviceLock lock(device, __func__);
+		solve.skyGain = (float)model.SkyGain();
+		solve.efficiency = (float)model.Efficiency();
+	}
+	if (result)
+	{
+		*result = solve;
+	}
+
+	return error;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorEstimateMoveTime(int id, float angle, int *ms)
+{
+	return WRRotatorEstimateMoveTimes(id, &angle, 1, ms);
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorEstimateMoveTimes(int id, const float *angles, int count, int *ms)
+{
+	if (!angles || !ms)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (count <= 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		if (!(angles[i] >= 0.0f && angles[i] < 360.0f))
+		{
+			return WR_ERROR_INVALID_PARAMETER;
+		}
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	/* Model constants are known once the device has been opened */
+	if (!device->traits)
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	EstimateMoveSequence(device, angles, count, ms);
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorQueueTarget(int id, float angle)
+{
+	if (!(angle >= 0.0f && angle < 360.0f))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (device->targetCount >= WR_TARGET_QUEUE_LEN)
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	device->targets[device->targetCount++] = angle;
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorClearTargets(int id)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	device->targetCount = 0;
+	return WR_SUCCESS;
+}
+
+/* Share of an idle window kept free for estimate error, plus a fixed allowance */
+static const double WINDOW_MARGIN_FRACTION = 0.1;
+static const int WINDOW_MARGIN_MS = 100;
+
+/* Drop the first queued target, caller holds the device lock */
+static void PopTarget(const std::shared_ptr<Device> &device)
+{
+	device->targetCount--;
+	memmove(device->targets, device->targets + 1, device->targetCount * sizeof(float));
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorIdleWindow(int id, int windowMs, WR_WINDOW_RESULT *result)
+{
+	if (!result)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (windowMs < 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	/* Model constants are known once the device has been opened */
+	if (!device->traits)
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	/* A stale flag would hold back every queued target */
+	bool moving = IsMoving(device);
+
+	memset(result, 0, sizeof(*result));
+	if (device->targetCount == 0)
+	{
+		/* Nothing to prepare, just report when the current move ends */
+		result->target = device->status.position;
+		result->readyMs = RemainingMoveMs(*device);
+		result->ready = result->readyMs <= windowMs;
+		return WR_SUCCESS;
+	}
+
+	float target = device->targets[0];
+	int estimateMs;
+	EstimateMoveSequence(device, &target, 1, &estimateMs);
+
+	result->target = target;
+	result->readyMs = estimateMs;
+	result->pending = device->targetCount;
+
+	if (estimateMs == 0 && !moving)
+	{
+		/* Already there */
+		PopTarget(device);
+		result->ready = 1;
+		result->pending = device->targetCount;
+		return WR_SUCCESS;
+	}
+
+	/* Never start a move that could still be running when the window closes,
+	 * nor one behind a move in flight: its end is only an estimate.
+	 */
+	if (moving || estimateMs * (1.0 + WINDOW_MARGIN_FRACTION) + WINDOW_MARGIN_MS > windowMs)
+	{
+		WR_DEBUG("Idle window of %d ms too short for %.3f degrees (%d ms)", windowMs, target, estimateMs);
+		return WR_SUCCESS;
+	}
+
+	PopTarget(device);
+	int pending = device->targetCount;
+
+	bool issued;
+	WR_ERROR_TYPE error = MoveToLocked(lock, device, target, &issued);
+	if (error != WR_SUCCESS)
+	{
+		/* Still locked, a suppressed move returns success. Keep the target for the next window. */
+		memmove(device->targets + 1, device->targets, device->targetCount * sizeof(float));
+		device->targets[0] = target;
+		device->targetCount++;
+		return error;
+	}
+
+	/* Within the deadband of the actual position nothing was sent, the target is reached */
+	result->started = issued ? 1 : 0;
+	result->ready = 1;
+	result->readyMs = issued ? estimateMs : 0;
+	result->pending = pending;
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorStopMove(int id)
+{
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	/* Send stop command */
+	WR_HISTORY_ENTRY entry = MakeHistoryEntry(device, WR_HISTORY_MOVE_STOPPED);
+	bool sent = SendCommand(device, "stop");
+	entry.error = sent ? WR_SUCCESS : WR_ERROR_COMMUNICATION;
+	entry.elapsedMs = (int)((TraceNowUs() - entry.timestampUs) / 1000);
+	device->history.Record(entry);
+	if (!sent)
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	/* The rotator halts somewhere along the way, re-read it before trusting the cache.
+	 * No overshoot return may follow a stop.
+	 */
+	device->overshooting = 0;
+	device->status.moving = 0;
+	device->positionValid = false;
+	NotifyChange(device, WR_NOTIFY_MOVING);
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRStartMetricsServer(const char *endpoint)
+{
+	if (!endpoint)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!StartMetricsServer(endpoint))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRStopMetricsServer(void)
+{
+	StopMetricsServer();
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRFormatMetrics(char *buffer, int length, int *needed)
+{
+	if (!buffer || !needed)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	std::string text = FormatMetrics();
+	*needed = (int)text.size() + 1;
+	if (length < *needed)
+	{
+		/* Caller retries with a buffer of *needed bytes */
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	memcpy(buffer, text.c_str(), text.size() + 1);
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRSetThreadPolicy(WR_THREAD_CLASS threadClass, const WR_THREAD_POLICY *policy)
+{
+	if (!policy)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!SetThreadPolicy(threadClass, policy))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRGetThreadPolicy(WR_THREAD_CLASS threadClass, WR_THREAD_POLICY *policy)
+{
+	if (!policy)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (!GetThreadPolicy(threadClass, policy))
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	return WR_SUCCESS;
+}
+
+WRAPI WR_ERROR_TYPE WRRotatorLinkTest(int id, int iterations, WR_LINK_STATS *stats)
+{
+	if (!stats)
+	{
+		return WR_ERROR_NULL_POINTER;
+	}
+
+	if (iterations <= 0)
+	{
+		return WR_ERROR_INVALID_PARAMETER;
+	}
+
+	auto device = FindDevice(id);
+	if (!device)
+	{
+		return WR_ERROR_INVALID_ID;
+	}
+
+	DeviceLock lock(device, __func__);
+
+	if (!device->port || !device->port->IsOpen())
+	{
+		return WR_ERROR_COMMUNICATION;
+	}
+
+	/* Queries would be interleaved with move feedback */
+	if (IsMoving(device))
+	{
+		return WR_ERROR_INVALID_STATE;
+	}
+
+	/* Walk the gap ladder down, spending an equal share of the iterations on
+	 * each rung, but at least LINK_TEST_MIN_PER_RUNG, so few iterations test
+	 * fewer rungs. The first rung with a bad response ends the descent and
+	 * the remaining iterations run at the last clean gap.
+	 */
+	int perRung = std::max(LINK_TEST_MIN_PER_RUNG, iterations / LINK_TEST_GAP_COUNT);
+	int rung = 0;
+	int rungCount = 0;
+	bool rungFailed = false;
+	bool descending = true;
+	int safeGapMs = -1;
+
+	std::vector<double> roundTripsMs;
+	roundTripsMs.reserve(iterations);
+	long long bytesReceived = 0;
+	long long errorBytes = 0;
+	int failures = 0;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		LinkProbe probe;
+		bool intact = QueryLinkProbe(device, LINK_TEST_GAPS_MS[rung], &probe);
+
+		bytesReceived += probe.bytesReceived;
+		errorBytes += probe.errorBytes;
+		if (intact)
+		{
+			roundTripsMs.push_back(probe.roundTripUs / 1000.0);
+		}
+		else
+		{
+			failures++;
+			rungFailed = true;
+		}
+
+		if (descending && ++rungCount >= perRung)
+		{
+			if (rungFailed)
+			{
+				descending = false;
+				if (rung > 0)
+				{
+					rung--;
+				}
+			}
+			else
+			{
+				safeGapMs = LINK_TEST_GAPS_MS[rung];
+				if (rung + 1 < LINK_TEST_GAP_COUNT)
+				{
+					rung++;
+				}
+				else
+				{
+					descending = false;
+				}
+			}
+			rungCount = 0;
+			rungFailed = false;
+		}
+	}
+
+	memset(stats, 0, sizeof(*stats));
+	stats->iterations = iterations;
+	stats->failures = failures;
+	stats->byteErrorRate = bytesReceived > 0 ? (float)errorBytes / bytesReceived : (errorBytes > 0 ? 1.0f : 0.0f);
+	stats->minSafeGapMs = safeGapMs;
+
+	if (!roundTripsMs.empty())
+	{
+		std::sort(roundTripsMs.begin(), roundTripsMs.end());
+		size_t n = roundTripsMs.size();
+		size_t p99Rank = std::max<size_t>(1, (size_t)ceil(0.99 * n));
+
+		double mean = 0.0;
+		for (double rtt : roundTripsMs)
+		{
+			mean += rtt;
+		}
+		mean /= n;
+
+		double variance = 0.0;
+		for (double rtt : roundTripsMs)
+		{
+			variance += (rtt - mean) * (rtt - mean);
+		}
+		variance /= n;
+
+		stats->minRoundTripMs = roundTripsMs[0];
+		stats->medianRoundTripMs = roundTripsMs[n / 2];
+		stats->p99RoundTripMs = roundTripsMs[p99Rank - 1];
+		stats->jitterMs = sqrt(variance);
+
+		/* Feed the measurements into pacing and timeouts. Only queries were
+		 * tested, so moves, settings and handshakes keep their gap.
+		 */
+		if (safeGapMs >= 0)
+		{
+			device->queryGapMs = safeGapMs;
+		}
+		int timeoutMs = (int)ceil(stats->p99RoundTripMs * LINK_TIMEOUT_FACTOR);
+		device->responseTimeoutMs = std::min(LINK_TIMEOUT_MAX_MS, std::max(LINK_TIMEOUT_MIN_MS, timeoutMs));
+	}
+
+	stats->appliedGapMs = device->queryGapMs;
+	stats->appliedTimeoutMs = device->responseTimeoutMs;
+
+	WR_INFO("Link test: %d/%d clean, median %.1f ms, p99 %.1f ms, safe gap %d ms",
+	        iterations - failures, iterations, stats->medianRoundTripMs, stats->p99RoundTripMs, safeGapMs);
+
+	return WR_SUCCESS;
+}
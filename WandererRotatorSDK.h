@@ -35,8 +35,11 @@ extern "C" {
 #define WRAPI
 #endif
 
-#define WR_MAX_NUM          32      /* Maximum rotator numbers supported by this SDK */
+#define WR_MAX_NUM          32      /* Rotators reported by WRRotatorScan(), see WRRotatorScanEx() for more */
 #define WR_VERSION_LEN      32      /* Buffer length for version strings */
+#define WR_PROFILE_NAME_LEN 32      /* Buffer length for profile names, including the terminator */
+#define WR_HISTORY_LEN      64      /* Events kept per device by WRRotatorGetHistory() */
+#define WR_TARGET_QUEUE_LEN 16      /* Targets queued per device by WRRotatorQueueTarget() */
 
 typedef enum _WR_ERROR_TYPE {
 	WR_SUCCESS = 0,                     /* Success */
@@ -45,6 +48,9 @@ typedef enum _WR_ERROR_TYPE {
 	WR_ERROR_INVALID_STATE,             /* Device is not in correct state for specific API call */
 	WR_ERROR_COMMUNICATION,             /* Data communication error such as device has been removed from USB port */
 	WR_ERROR_NULL_POINTER,              /* Caller passes null-pointer parameter which is not expected */
+	WR_ERROR_NOT_SUPPORTED,             /* Model is unknown or does not support the requested command */
+	WR_ERROR_NOT_CONVERGED,             /* Closed-loop positioning did not reach the tolerance */
+	WR_ERROR_PORT_BUSY,                 /* Serial port is held by another process, see WRRotatorGetPortOwner() */
 } WR_ERROR_TYPE;
 
 /*
@@ -63,6 +69,26 @@ typedef struct _WR_VERSION
 	char model[8];                      /* Model type (e.g., "Lite", "Mini") */
 } WR_VERSION;
 
+/*
+ * Commands a model understands, used in WR_MODEL_TRAITS.commands
+ */
+#define WR_MODEL_CMD_MOVE                       0x01    /* Relative move (1000000 + steps) */
+#define WR_MODEL_CMD_BACKLASH                   0x02    /* Backlash setting (1600000 + 10*x) */
+#define WR_MODEL_CMD_REVERSE                    0x04    /* Reverse direction (1700000/1700001) */
+#define WR_MODEL_CMD_SYNC                       0x08    /* Set current position as zero (1500002) */
+#define WR_MODEL_CMD_ALL                        0x0F
+
+typedef struct _WR_MODEL_TRAITS
+{
+	char model[8];                      /* Model name as reported in the handshake (e.g., "LiteV2") */
+	int stepsPerDegree;                 /* Motor steps per degree of rotation */
+	float stepRate;                     /* Nominal average step rate during a move (steps/s) */
+	float maxSpeed;                     /* Maximum travel speed (degrees/s) */
+	int overheadMs;                     /* Fixed time per move on top of travel (ms) */
+	int settleMs;                       /* Time to settle after a move before the next one (ms) */
+	unsigned int commands;              /* WR_MODEL_CMD_xxx bits */
+} WR_MODEL_TRAITS;
+
 typedef struct _WR_ROTATOR_CONFIG
 {
 	unsigned int mask;          /* Used by WRRotatorSetConfig() to indicate which field wants to be set */
@@ -73,6 +99,11 @@ typedef struct _WR_ROTATOR_CONFIG
 	int overshotDirection; 		/* Backlash overshoot direction: 0 - normal, others - reverse */
 } WR_ROTATOR_CONFIG;
 
+typedef struct _WR_PROFILE {
+	WR_ROTATOR_CONFIG config;           /* All fields are applied, mask is ignored */
+	float deadband;                     /* See WRRotatorSetDeadband() */
+} WR_PROFILE;
+
 typedef struct _WR_ROTATOR_STATUS {
 	float position;                     /* Current motor position in degrees */
 	int moving;                         /* 0 - motor is not moving, others - Motor is moving */
@@ -80,8 +111,168 @@ typedef struct _WR_ROTATOR_STATUS {
 	float stepSize;                     /* Step size in degrees per step */
 } WR_ROTATOR_STATUS;
 
+typedef struct _WR_SERIAL_PROFILE {
+	int baudRate;                       /* 9600, 19200 (default), 38400, 57600, 115200 or 230400 */
+	int lowLatency;                     /* 0 - driver default, others - request the driver's low-latency mode */
+	int drainOnWrite;                   /* 0 - commands return once queued (default), others - wait until sent */
+	int txQueueLimit;                   /* Queued output bytes before a write waits for the UART (default 256) */
+	int exclusive;                      /* Others - lock the port against other processes (default), 0 - share it */
+} WR_SERIAL_PROFILE;
+
+typedef struct _WR_ROTATOR_STATS {
+	float position;                     /* Cached position in degrees */
+	int moving;                         /* 0 - idle, others - moving */
+	int phase;                          /* 0 - plain move or idle, 1 - overshoot out, 2 - overshoot return */
+	int etaMs;                          /* Estimated time until the current move completes, 0 if idle */
+	int lastMoveError;                  /* WR_ERROR_TYPE of the most recent move */
+	float latencyP50Ms;                 /* Query round-trip percentiles */
+	float latencyP90Ms;
+	float latencyP99Ms;
+	unsigned int queries;               /* Completed query round trips */
+	unsigned int commands;              /* Commands and queries written */
+	unsigned int moves;                 /* Move phases submitted */
+	unsigned int timeouts;              /* Response fields that never arrived */
+	unsigned int parseErrors;           /* Response fields that could not be parsed */
+	unsigned int reconnects;            /* Opens after the first one */
+	float stepRate;                     /* Effective step rate learned from completed moves (steps/s) */
+} WR_ROTATOR_STATS;
+
+typedef struct _WR_LINK_STATS {
+	int iterations;                     /* Queries sent */
+	int failures;                       /* Queries with missing, truncated or malformed responses */
+	float minRoundTripMs;               /* Fastest complete round trip */
+	float medianRoundTripMs;            /* Median complete round trip */
+	float p99RoundTripMs;               /* 99th percentile complete round trip */
+	float jitterMs;                     /* Standard deviation of complete round trips */
+	float byteErrorRate;                /* Bad bytes / received bytes (a missing field counts as one bad byte) */
+	int minSafeGapMs;                   /* Smallest inter-query gap with clean responses on every query of its rung, -1 if none */
+	int appliedGapMs;                   /* Gap before status queries from now on (other commands keep 100 ms) */
+	int appliedTimeoutMs;               /* Response timeout the SDK uses from now on */
+} WR_LINK_STATS;
+
+/*
+ * Threads created by the SDK, used by WRSetThreadPolicy()
+ */
+typedef enum _WR_THREAD_CLASS {
+	WR_THREAD_LISTENER = 0,             /* Move completion listener, one per opened device */
+	WR_THREAD_METRICS,                  /* Metrics server */
+	WR_THREAD_NOTIFY,                   /* Subscription dispatcher */
+	WR_THREAD_CLASS_COUNT
+} WR_THREAD_CLASS;
+
+#define WR_SCHED_INHERIT    0           /* Keep the scheduling of the creating thread */
+#define WR_SCHED_OTHER      1           /* SCHED_OTHER */
+#define WR_SCHED_FIFO       2           /* SCHED_FIFO, needs priority */
+#define WR_SCHED_RR         3           /* SCHED_RR, needs priority */
+
+typedef struct _WR_THREAD_POLICY {
+	int policy;                         /* One of WR_SCHED_xxx */
+	int priority;                       /* Real-time priority 1-99 for WR_SCHED_FIFO / WR_SCHED_RR */
+	unsigned long long cpuMask;         /* Bit n allows CPU n, 0 - keep inherited affinity */
+	char name[16];                      /* Thread name, empty - SDK default ("wr-listener", ...) */
+} WR_THREAD_POLICY;
+
+/*
+ * Events delivered to the callback set with WRRotatorSetEventCallback()
+ */
+typedef enum _WR_EVENT_TYPE {
+	WR_EVENT_MOVE_COMPLETE = 0,         /* Move finished, rotated and steps describe it */
+	WR_EVENT_MOVE_SUPPRESSED,           /* Move within the deadband, completed without motion */
+} WR_EVENT_TYPE;
+
+typedef struct _WR_EVENT {
+	int id;                             /* Device ID */
+	WR_EVENT_TYPE type;                 /* Event type */
+	long long timestampUs;              /* Monotonic time in microseconds */
+	float position;                     /* Position in degrees when the event was raised */
+	int steps;                          /* Requested (suppressed) or submitted (complete) steps */
+	float rotated;                      /* Degrees the device reported as rotated */
+	int error;                          /* WR_ERROR_TYPE, WR_SUCCESS unless the event reports a failure */
+} WR_EVENT;
+
+/* Called from SDK threads or the calling thread; keep it short */
+typedef void (*WR_EVENT_CALLBACK)(const WR_EVENT *event, void *context);
+
+/*
+ * Entries of the per-device event history, see WRRotatorGetHistory()
+ */
+typedef enum _WR_HISTORY_TYPE {
+	WR_HISTORY_MOVE_SUBMITTED = 0,      /* Move sent, steps of its first phase */
+	WR_HISTORY_MOVE_PHASE,              /* Overshoot return phase sent */
+	WR_HISTORY_MOVE_COMPLETE,           /* Move finished or failed, see error */
+	WR_HISTORY_MOVE_SUPPRESSED,         /* Move within the deadband, not sent */
+	WR_HISTORY_MOVE_STOPPED,            /* Stop command sent */
+	WR_HISTORY_TIMEOUT,                 /* A response field never arrived */
+	WR_HISTORY_OPEN,                    /* Device opened, steps counts the reconnects so far */
+	WR_HISTORY_CONFIG_WRITE,            /* Setting written to the device, see error */
+} WR_HISTORY_TYPE;
+
+typedef struct _WR_HISTORY_ENTRY {
+	unsigned long long sequence;        /* Per device, increasing; gaps are entries overwritten while reading */
+	WR_HISTORY_TYPE type;               /* Entry type */
+	long long timestampUs;              /* Monotonic time in microseconds */
+	float position;                     /* Position in degrees when recorded */
+	int steps;                          /* Steps submitted, requested or suppressed */
+	float rotated;                      /* Degrees the device reported as rotated (complete) */
+	int error;                          /* WR_ERROR_TYPE, WR_SUCCESS unless the entry reports a failure */
+	int expectedMs;                     /* Predicted duration (submitted, phase) */
+	int elapsedMs;                      /* Measured duration: phase (complete), wait (timeout), round trip (open, config write) */
+} WR_HISTORY_ENTRY;
+
+/*
+ * State change subscriptions, see WRRotatorSubscribe()
+ */
+#define WR_NOTIFY_POSITION  0x01        /* Position moved by at least positionThreshold */
+#define WR_NOTIFY_MOVING    0x02        /* A move started or finished */
+#define WR_NOTIFY_ERROR     0x04        /* A move failed, or a response timed out or was malformed */
+#define WR_NOTIFY_CONFIG    0x08        /* Configuration, profile, deadband, correction or sync changed */
+
+typedef struct _WR_SUBSCRIPTION {
+	unsigned int mask;                  /* WR_NOTIFY_xxx bits to report */
+	float positionThreshold;            /* Degrees since the last notification, 0 - every change */
+	float maxRate;                      /* Notifications per second, 0 - unlimited */
+} WR_SUBSCRIPTION;
+
+typedef struct _WR_NOTIFICATION {
+	int handle;                         /* Subscription handle */
+	int id;                             /* Device ID */
+	unsigned int changes;               /* WR_NOTIFY_xxx bits changed since the last notification */
+	long long timestampUs;              /* Monotonic delivery time in microseconds */
+	WR_ROTATOR_STATUS status;           /* Latest cached status */
+	int lastMoveError;                  /* WR_ERROR_TYPE of the most recent move */
+	unsigned int timeouts;              /* Response fields that never arrived */
+	unsigned int parseErrors;           /* Response fields that could not be parsed */
+} WR_NOTIFICATION;
+
+/* Called from the "wr-notify" thread, one notification at a time; may call WRUnsubscribe() */
+typedef void (*WR_NOTIFY_CALLBACK)(const WR_NOTIFICATION *notification, void *context);
+
+/* Measures the sky position angle in degrees, e.g. by plate solving an exposure.
+ * Return 0 on success, others to abort WRRotatorSolveTo().
+ */
+typedef int (*WR_MEASURE_CALLBACK)(int id, float *skyAngle, void *context);
+
+typedef struct _WR_SOLVE_RESULT {
+	int moves;                          /* Correction moves made */
+	int measurements;                   /* Measurement callbacks made */
+	float skyAngle;                     /* Last measured sky angle in degrees */
+	float error;                        /* Target minus last measured sky angle, in [-180, 180) */
+	float skyGain;                      /* Learned sky degrees per achieved degree (about +1 or -1) */
+	float efficiency;                   /* Learned achieved degrees per commanded degree */
+} WR_SOLVE_RESULT;
+
+typedef struct _WR_WINDOW_RESULT {
+	int started;                        /* 1 - a move to target was sent in this window, 0 if none was needed */
+	int ready;                          /* 1 - the rotator rests at target by the end of the window */
+	float target;                       /* Next queued target in degrees, current position if none */
+	int readyMs;                        /* Estimated time until the rotator rests at target */
+	int pending;                        /* Targets still queued, including target unless it was started or reached */
+} WR_WINDOW_RESULT;
+
 /* Device scanning and management */
-WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids);
+WRAPI WR_ERROR_TYPE WRRotatorScan(int *number, int *ids);    /* ids holds WR_MAX_NUM entries, at most that many reported */
+WRAPI WR_ERROR_TYPE WRRotatorScanEx(int *number, int *ids, int capacity);       /* *number: all found, ids: first capacity */
+WRAPI WR_ERROR_TYPE WRRotatorListDevices(int *number, int *ids, int capacity);  /* Known devices, no scan */
 WRAPI WR_ERROR_TYPE WRRotatorOpen(int id);
 WRAPI WR_ERROR_TYPE WRRotatorClose(int id);
 
@@ -89,19 +280,79 @@ WRAPI WR_ERROR_TYPE WRRotatorClose(int id);
 WRAPI WR_ERROR_TYPE WRRotatorGetConfig(int id, WR_ROTATOR_CONFIG *config);
 WRAPI WR_ERROR_TYPE WRRotatorSetConfig(int id, WR_ROTATOR_CONFIG *config);
 
+/* Named configuration profiles (shared by all devices) */
+WRAPI WR_ERROR_TYPE WRSaveProfile(const char *name, const WR_PROFILE *profile);
+WRAPI WR_ERROR_TYPE WRGetProfile(const char *name, WR_PROFILE *profile);
+WRAPI WR_ERROR_TYPE WRDeleteProfile(const char *name);
+WRAPI WR_ERROR_TYPE WRRotatorSaveProfile(int id, const char *name);     /* Capture the device's current settings */
+WRAPI WR_ERROR_TYPE WRRotatorApplyProfile(int id, const char *name);    /* Writes only differing fields, never during a move */
+WRAPI WR_ERROR_TYPE WRRotatorGetActiveProfile(int id, char *name);      /* WR_PROFILE_NAME_LEN buffer, empty if none */
+
+/* Serial line settings (applied immediately if open, and on every open) */
+WRAPI WR_ERROR_TYPE WRRotatorGetSerialProfile(int id, WR_SERIAL_PROFILE *profile);
+WRAPI WR_ERROR_TYPE WRRotatorSetSerialProfile(int id, const WR_SERIAL_PROFILE *profile);
+WRAPI WR_ERROR_TYPE WRRotatorGetPortOwner(int id, int *pid);   /* Other process with the port open, 0 if none */
+
+/* Motion tuning */
+WRAPI WR_ERROR_TYPE WRRotatorSetDeadband(int id, float degrees);     /* Moves smaller than this are suppressed */
+WRAPI WR_ERROR_TYPE WRRotatorGetDeadband(int id, float *degrees);
+
+/* Angle error correction (true minus reported angle per mechanical angle, count 0 clears) */
+WRAPI WR_ERROR_TYPE WRRotatorSetCorrectionTable(int id, const float *angles, const float *errors, int count);
+WRAPI WR_ERROR_TYPE WRRotatorLoadCorrectionTable(int id, const char *path);   /* "angle error" lines, '#' comments */
+
+/* Events */
+WRAPI WR_ERROR_TYPE WRRotatorSetEventCallback(int id, WR_EVENT_CALLBACK callback, void *context);
+WRAPI WR_ERROR_TYPE WRRotatorGetHistory(int id, WR_HISTORY_ENTRY *entries, int capacity, int *count);  /* Oldest first, never blocks */
+WRAPI WR_ERROR_TYPE WRRotatorSubscribe(int id, const WR_SUBSCRIPTION *subscription,
+                                       WR_NOTIFY_CALLBACK callback, void *context, int *handle);
+WRAPI WR_ERROR_TYPE WRUnsubscribe(int handle);   /* Callback no longer runs once this returns */
+
 /* Status and information */
 WRAPI WR_ERROR_TYPE WRRotatorGetStatus(int id, WR_ROTATOR_STATUS *status);
 WRAPI WR_ERROR_TYPE WRRotatorGetVersion(int id, WR_VERSION *version);
+WRAPI WR_ERROR_TYPE WRRotatorGetModelTraits(int id, WR_MODEL_TRAITS *traits);
+WRAPI WR_ERROR_TYPE WRRotatorGetStats(int id, WR_ROTATOR_STATS *stats);    /* Cached only, no serial traffic */
 
 /* Motion control */
 WRAPI WR_ERROR_TYPE WRRotatorFindHome(int id);
 WRAPI WR_ERROR_TYPE WRRotatorSyncPosition(int id, float angle);
 WRAPI WR_ERROR_TYPE WRRotatorMove(int id, float angle);
 WRAPI WR_ERROR_TYPE WRRotatorMoveTo(int id, float angle);
+WRAPI WR_ERROR_TYPE WRRotatorMoveSteps(int id, int steps);     /* Relative move in motor steps, positive = CCW */
 WRAPI WR_ERROR_TYPE WRRotatorStopMove(int id);
 
+/* Closed-loop positioning on the sky (blocks until done, result may be NULL) */
+WRAPI WR_ERROR_TYPE WRRotatorSolveTo(int id, float skyAngle, float tolerance, int maxMoves,
+                                     WR_MEASURE_CALLBACK measure, void *context, WR_SOLVE_RESULT *result);
+
+/* Pre-positioning: queued targets are moved to inside declared idle windows */
+WRAPI WR_ERROR_TYPE WRRotatorQueueTarget(int id, float angle);
+WRAPI WR_ERROR_TYPE WRRotatorClearTargets(int id);
+WRAPI WR_ERROR_TYPE WRRotatorIdleWindow(int id, int windowMs, WR_WINDOW_RESULT *result);   /* Safe to move for windowMs from now */
+
+/* Planning (no motion, no serial traffic) */
+WRAPI WR_ERROR_TYPE WRRotatorEstimateMoveTime(int id, float angle, int *ms);   /* MoveTo angle until settled */
+WRAPI WR_ERROR_TYPE WRRotatorEstimateMoveTimes(int id, const float *angles, int count, int *ms);   /* ms[i]: from angles[i-1] (or now) to angles[i] */
+
+/* Diagnostics */
+WRAPI WR_ERROR_TYPE WRRotatorLinkTest(int id, int iterations, WR_LINK_STATS *stats);
+
+/* Metrics export (OpenMetrics text format) */
+WRAPI WR_ERROR_TYPE WRStartMetricsServer(const char *endpoint);    /* "unix:/path", "host:port" or ":port" (127.0.0.1) */
+WRAPI WR_ERROR_TYPE WRStopMetricsServer(void);
+WRAPI WR_ERROR_TYPE WRFormatMetrics(char *buffer, int length, int *needed);
+
+/* Hardware models (registered models override built-in ones, used from the next open) */
+WRAPI WR_ERROR_TYPE WRRegisterModel(const WR_MODEL_TRAITS *traits);
+
+/* Thread scheduling (applies to threads started after the call, and to listeners at their next move) */
+WRAPI WR_ERROR_TYPE WRSetThreadPolicy(WR_THREAD_CLASS threadClass, const WR_THREAD_POLICY *policy);
+WRAPI WR_ERROR_TYPE WRGetThreadPolicy(WR_THREAD_CLASS threadClass, WR_THREAD_POLICY *policy);
+
 /* Utility */
 WRAPI WR_ERROR_TYPE WRGetSDKVersion(char *version);
+WRAPI WR_ERROR_TYPE WRSetTraceFile(const char *path);   /* Capture serial trace for wrtrace, NULL to stop */
 
 #ifdef __cplusplus
 }
@@ -24,10 +24,17 @@
 
 #include "WandererRotatorSerialPort.h"
 #include "WandererRotatorLogging.h"
+#include "WandererRotatorTrace.h"
 #include <unistd.h>
 #include <fcntl.h>
 #include <termios.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
 #include <sys/select.h>
+#include <sys/file.h>
+#include <dirent.h>
+#include <climits>
+#include <cstdlib>
 #include <cerrno>
 #include <cctype>
 #include <chrono>
@@ -36,20 +43,268 @@
 
 namespace WandererRotator
 {
-    bool SerialPort::Open(const char *portName)
+    /* Map a numeric baud rate to its termios constant, 0 if unsupported */
+    static speed_t BaudToSpeed(int baudRate)
+    {
+        switch (baudRate)
+        {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 115200:
+            return B115200;
+        case 230400:
+            return B230400;
+        default:
+            return 0;
+        }
+    }
+
+    bool SerialPort::IsSupportedBaudRate(int baudRate)
+    {
+        return BaudToSpeed(baudRate) != 0;
+    }
+
+    bool SerialPort::ApplyLowLatency()
+    {
+        struct serial_struct serial;
+        if (ioctl(fd, TIOCGSERIAL, &serial) != 0)
+        {
+            WR_DEBUG("SerialPort: %s does not support TIOCGSERIAL (errno=%d)", name.c_str(), errno);
+            return false;
+        }
+
+        if (profile.lowLatency)
+            serial.flags |= ASYNC_LOW_LATENCY;
+        else
+            serial.flags &= ~ASYNC_LOW_LATENCY;
+
+        if (ioctl(fd, TIOCSSERIAL, &serial) != 0)
+        {
+            WR_DEBUG("SerialPort: %s refused low latency flag (errno=%d)", name.c_str(), errno);
+            return false;
+        }
+        return true;
+    }
+
+    bool SerialPort::Claim()
+    {
+        /* Advisory lock for cooperating processes */
+        if (flock(fd, LOCK_EX | LOCK_NB) != 0)
+        {
+            return false;
+        }
+
+        /* Make open() by anyone else (except root) fail with EBUSY */
+        if (ioctl(fd, TIOCEXCL) != 0)
+        {
+            WR_DEBUG("SerialPort: %s refused TIOCEXCL (errno=%d)", name.c_str(), errno);
+        }
+        return true;
+    }
+
+    int SerialPort::FindOwnerPid(const char *portName)
+    {
+        char device[PATH_MAX];
+        if (!realpath(portName, device))
+        {
+            return 0;
+        }
+
+        DIR *proc = opendir("/proc");
+        if (!proc)
+        {
+            return 0;
+        }
+
+        int self = getpid();
+        int owner = 0;
+        struct dirent *process;
+        while (!owner && (process = readdir(proc)) != NULL)
+        {
+            int pid = atoi(process->d_name);
+            if (pid <= 0 || pid == self)
+            {
+                continue;
+            }
+
+            char fdPath[64];
+            snprintf(fdPath, sizeof(fdPath), "/proc/%d/fd", pid);
+            DIR *fds = opendir(fdPath);
+            if (!fds)
+            {
+                continue;
+            }
+
+            struct dirent *entry;
+            while ((entry = readdir(fds)) != NULL)
+            {
+                char linkPath[PATH_MAX], target[PATH_MAX];
+                snprintf(linkPath, sizeof(linkPath), "%s/%s", fdPath, entry->d_name);
+                ssize_t len = readlink(linkPath, target, sizeof(target) - 1);
+                if (len > 0)
+                {
+                    target[len] = '\0';
+                    if (strcmp(target, device) == 0)
+                    {
+                        owner = pid;
+                        break;
+                    }
+                }
+            }
+            closedir(fds);
+        }
+
+        closedir(proc);
+        return owner;
+    }
+
+    bool SerialPort::ApplyProfile(const SerialProfile &settings)
+    {
+        speed_t speed = BaudToSpeed(settings.baudRate);
+        if (speed == 0 || settings.txQueueLimit < 0)
+        {
+            return false;
+        }
+
+        /* Claim the port before touching the line, so a refused claim leaves
+         * everything as it was. Downgrading can't fail and is done last.
+         */
+        bool claimed = false;
+        if (fd >= 0 && settings.exclusive && !profile.exclusive)
+        {
+            if (!Claim())
+            {
+                WR_ERROR("SerialPort::ApplyProfile: %s is in use by another process", name.c_str());
+                return false;
+            }
+            claimed = true;
+        }
+
+        if (fd >= 0 && settings.baudRate != profile.baudRate)
+        {
+            struct termios tty;
+            bool applied = tcgetattr(fd, &tty) == 0;
+            if (applied)
+            {
+                /* Let pending output leave at the old speed */
+                tcdrain(fd);
+                cfsetispeed(&tty, speed);
+                cfsetospeed(&tty, speed);
+                applied = tcsetattr(fd, TCSANOW, &tty) == 0;
+                if (!applied)
+                {
+                    WR_ERROR("SerialPort::ApplyProfile: tcsetattr failed (errno=%d)", errno);
+                }
+            }
+
+            if (!applied)
+            {
+                if (claimed)
+                {
+                    /* Back to the shared hold this port had before */
+                    ioctl(fd, TIOCNXCL);
+                    flock(fd, LOCK_SH | LOCK_NB);
+                }
+                return false;
+            }
+        }
+
+        if (fd >= 0 && !settings.exclusive && profile.exclusive)
+        {
+            /* Downgrade, so exclusive openers elsewhere still see this one */
+            ioctl(fd, TIOCNXCL);
+            flock(fd, LOCK_SH | LOCK_NB);
+        }
+
+        bool lowLatencyChanged = settings.lowLatency != profile.lowLatency;
+        profile = settings;
+
+        if (fd >= 0 && lowLatencyChanged)
+        {
+            /* Best effort, not every driver supports it */
+            ApplyLowLatency();
+        }
+        return true;
+    }
+
+    bool SerialPort::Open(const char *portName, const SerialProfile &settings)
     {
         WR_DEBUG("SerialPort::Open: Attempting to open %s", portName);
 
+        speed_t speed = BaudToSpeed(settings.baudRate);
+        if (speed == 0)
+        {
+            WR_ERROR("SerialPort::Open: Unsupported baud rate %d", settings.baudRate);
+            return false;
+        }
+
+        /* Reopening replaces the previous descriptor, which would otherwise hold the lock */
+        Close();
+        busy = false;
+        ownerPid = 0;
+
         /* Open without O_NONBLOCK to allow blocking I/O */
         fd = open(portName, O_RDWR | O_NOCTTY);
         WR_DEBUG("SerialPort::Open: open() returned fd=%d", fd);
 
         if (fd < 0)
         {
+            /* EBUSY: another process holds the tty with TIOCEXCL */
+            if (errno == EBUSY)
+            {
+                busy = true;
+                ownerPid = FindOwnerPid(portName);
+                WR_ERROR("SerialPort::Open: %s is in use by pid %d", portName, ownerPid);
+                return false;
+            }
             WR_ERROR("SerialPort::Open: Failed to open port %s (errno=%d)", portName, errno);
             return false;
         }
 
+        name = portName;
+        profile = settings;
+
+        if (profile.exclusive)
+        {
+            if (!Claim())
+            {
+                busy = true;
+                ownerPid = FindOwnerPid(portName);
+                WR_ERROR("SerialPort::Open: %s is locked by pid %d", portName, ownerPid);
+                close(fd);
+                fd = -1;
+                return false;
+            }
+        }
+        else
+        {
+            /* Shared lock, so exclusive openers elsewhere still see this one.
+             * It fails only while someone else holds the port exclusively.
+             */
+            if (flock(fd, LOCK_SH | LOCK_NB) != 0)
+            {
+                busy = true;
+                ownerPid = FindOwnerPid(portName);
+                WR_ERROR("SerialPort::Open: %s is locked by pid %d", portName, ownerPid);
+                close(fd);
+                fd = -1;
+                return false;
+            }
+
+            /* Shared use was asked for, but say so: interleaved commands garble each other */
+            int otherPid = FindOwnerPid(portName);
+            if (otherPid)
+            {
+                WR_ERROR("SerialPort::Open: %s is also open in pid %d", portName, otherPid);
+            }
+        }
+
         struct termios tty;
         if (tcgetattr(fd, &tty) != 0)
         {
@@ -59,9 +314,9 @@ namespace WandererRotator
             return false;
         }
 
-        /* Set 19200 baud rate */
-        cfsetispeed(&tty, B19200);
-        cfsetospeed(&tty, B19200);
+        /* Set baud rate from profile (19200 by default) */
+        cfsetispeed(&tty, speed);
+        cfsetospeed(&tty, speed);
 
         /* Control Mode Flags (c_cflag) */
         tty.c_cflag &= ~(CSIZE | CSTOPB | PARENB | PARODD | HUPCL | CRTSCTS);
@@ -140,6 +395,12 @@ namespace WandererRotator
         WR_DEBUG("SerialPort::Open: tcsetattr succeeded");
 
         tcflush(fd, TCIOFLUSH);
+
+        if (profile.lowLatency)
+        {
+            ApplyLowLatency();
+        }
+
         WR_DEBUG("SerialPort::Open: Successfully opened %s (fd=%d)", portName, fd);
         return true;
     }
@@ -148,6 +409,11 @@ namespace WandererRotator
     {
         if (fd >= 0)
         {
+            /* Closing drops the advisory lock, TIOCEXCL must be cleared explicitly */
+            if (profile.exclusive)
+            {
+                ioctl(fd, TIOCNXCL);
+            }
             close(fd);
             fd = -1;
         }
@@ -159,17 +425,60 @@ namespace WandererRotator
         {
             return false;
         }
-        int written = write(fd, data, len);
+        /* Only wait for the wire if the output queue is over its limit */
+        int queued = 0;
+        if (ioctl(fd, TIOCOUTQ, &queued) == 0 && queued + len > profile.txQueueLimit)
+        {
+            tcdrain(fd);
+        }
+
+        int written = 0;
+        while (written < len)
+        {
+            ssize_t n = write(fd, data + written, len - written);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+                break;
+            written += n;
+        }
+
         WR_DEBUG("Write: fd=%d, wrote %d/%d bytes", fd, written, len);
-        /* Wait for all data to be sent */
-        tcdrain(fd);
+        if (TraceEnabled())
+        {
+            char text[64];
+            TraceWrite(GetName(), WR_TRACE_TX, "data=%s", TraceData(data, len, text, sizeof(text)));
+        }
+
+        if (profile.drainOnWrite)
+        {
+            tcdrain(fd);
+        }
         return written == len;
     }
 
+    void SerialPort::Drain()
+    {
+        if (fd >= 0)
+        {
+            tcdrain(fd);
+        }
+    }
+
+    void SerialPort::FlushInput()
+    {
+        if (fd >= 0)
+        {
+            tcdrain(fd);
+            tcflush(fd, TCIFLUSH);
+        }
+    }
+
     int SerialPort::Read(unsigned char *buf, int maxlen, char stop_char, int timeoutMs)
     {
         int bytesRead = 0;
         auto startTime = std::chrono::high_resolution_clock::now();
+        long long traceStart = TraceEnabled() ? TraceNowUs() : 0;
 
         while (bytesRead < maxlen - 1)
         {
@@ -202,6 +511,12 @@ namespace WandererRotator
             {
                 bytesRead++;
                 buf[bytesRead] = '\0';
+                if (TraceEnabled())
+                {
+                    char text[64];
+                    TraceWrite(GetName(), WR_TRACE_RX, "data=%s us=%lld",
+                               TraceData(buf, bytesRead, text, sizeof(text)), TraceNowUs() - traceStart);
+                }
                 return bytesRead;
             }
 
@@ -209,6 +524,12 @@ namespace WandererRotator
         }
 
         buf[bytesRead] = '\0';
+        if (TraceEnabled())
+        {
+            char text[64];
+            TraceWrite(GetName(), WR_TRACE_TIMEOUT, "us=%lld data=%s",
+                       TraceNowUs() - traceStart, TraceData(buf, bytesRead, text, sizeof(text)));
+        }
         return bytesRead;
     }
 
@@ -31,12 +31,34 @@
  * Low-level serial port communication with select()-based timeout handling.
  * ============================================================================ */
 
+#include <string>
+
 namespace WandererRotator
 {
+	/**
+	 * Line settings and write behaviour of a serial port.
+	 */
+	struct SerialProfile
+	{
+		int baudRate = 19200;	   /* Line speed, see SerialPort::IsSupportedBaudRate() */
+		bool lowLatency = false;   /* Request ASYNC_LOW_LATENCY from the driver */
+		bool drainOnWrite = false; /* Block in Write() until the UART has sent everything */
+		int txQueueLimit = 256;	   /* Bytes allowed in the kernel output queue before Write() waits */
+		bool exclusive = true;	   /* Hold an advisory lock and TIOCEXCL while open */
+	};
+
 	class SerialPort
 	{
 	private:
 		int fd = -1;
+		std::string name;
+		SerialProfile profile;
+
+		bool busy = false;
+		int ownerPid = 0;
+
+		bool ApplyLowLatency();
+		bool Claim();
 
 	public:
 		SerialPort() {}
@@ -44,10 +66,39 @@ namespace WandererRotator
 
 		/**
 		 * Open a serial port device.
+		 *
+		 * With settings.exclusive the port is locked against other
+		 * processes; if another process holds it, Open() fails at once and
+		 * IsBusy() / GetOwnerPid() tell who. Without it, a port shared with
+		 * another process is only reported in the log.
+		 *
 		 * @param portName Device path (e.g., "/dev/ttyUSB0")
+		 * @param settings Line settings and write behaviour
 		 * @return true if successfully opened and configured
 		 */
-		bool Open(const char *portName);
+		bool Open(const char *portName, const SerialProfile &settings = SerialProfile());
+
+		/**
+		 * Change line settings of an open port, or store them for the next Open().
+		 * @param settings Line settings and write behaviour
+		 * @return true if the settings are valid and were applied, otherwise
+		 *         the port keeps its previous settings and lock
+		 */
+		bool ApplyProfile(const SerialProfile &settings);
+
+		/**
+		 * Check if a baud rate can be used in a SerialProfile.
+		 */
+		static bool IsSupportedBaudRate(int baudRate);
+
+		/**
+		 * Find a process other than this one with the device open, by
+		 * walking /proc. Only processes of the same user (or all, as root)
+		 * can be seen.
+		 * @param portName Device path
+		 * @return Process ID, or 0 if none was found
+		 */
+		static int FindOwnerPid(const char *portName);
 
 		/**
 		 * Close the serial port.
@@ -56,12 +107,28 @@ namespace WandererRotator
 
 		/**
 		 * Write data to the serial port.
+		 *
+		 * Bytes are queued in the kernel and sent asynchronously; the call only
+		 * waits if the output queue is over the profile's txQueueLimit or the
+		 * profile asks for drainOnWrite.
+		 *
 		 * @param data Buffer containing data to write
 		 * @param len Number of bytes to write
-		 * @return true if all bytes were successfully written
+		 * @return true if all bytes were successfully queued
 		 */
 		bool Write(const unsigned char *data, int len);
 
+		/**
+		 * Wait until all queued output has been sent.
+		 */
+		void Drain();
+
+		/**
+		 * Discard unread input. Queued output is sent first, so a command
+		 * written before the flush is never lost.
+		 */
+		void FlushInput();
+
 		/**
 		 * Read data from the serial port with timeout.
 		 *
@@ -87,6 +154,23 @@ namespace WandererRotator
 		 * @return File descriptor or -1 if closed
 		 */
 		int GetFD() { return fd; }
+
+		/**
+		 * Get the device path the port was opened with.
+		 * @return Device path or empty string if never opened
+		 */
+		const char *GetName() { return name.c_str(); }
+
+		/**
+		 * Whether the last Open() failed because another process holds the port.
+		 */
+		bool IsBusy() { return busy; }
+
+		/**
+		 * Process holding the port when the last Open() failed as busy.
+		 * @return Process ID, or 0 if unknown
+		 */
+		int GetOwnerPid() { return ownerPid; }
 	};
 
 } /* namespace WandererRotator */
@@ -0,0 +1,106 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorSkyModel.h"
+#include <cmath>
+
+namespace WandererRotator
+{
+	/* Combined gains below this are treated as their sign, so a noisy
+	 * early fit cannot turn a small error into a huge command.
+	 */
+	static constexpr double SKY_MODEL_MIN_GAIN = 0.5;
+
+	double WrapDegrees(double degrees)
+	{
+		double wrapped = fmod(degrees + 180.0, 360.0);
+		if (wrapped < 0.0)
+		{
+			wrapped += 360.0;
+		}
+		return wrapped - 180.0;
+	}
+
+	void SkyModel::Reset()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		anchored = false;
+		offset = 0.0;
+		achievedSkySum = achievedSquareSum = SKY_MODEL_PRIOR_WEIGHT;
+		commandedAchievedSum = commandedSquareSum = SKY_MODEL_PRIOR_WEIGHT;
+	}
+
+	bool SkyModel::Anchored() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return anchored;
+	}
+
+	void SkyModel::Anchor(double mechanicalDegrees, double skyDegrees)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		offset = skyDegrees - (achievedSkySum / achievedSquareSum) * mechanicalDegrees;
+		anchored = true;
+	}
+
+	double SkyModel::PredictSky(double mechanicalDegrees) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		double sky = fmod(offset + (achievedSkySum / achievedSquareSum) * mechanicalDegrees, 360.0);
+		return sky < 0.0 ? sky + 360.0 : sky;
+	}
+
+	double SkyModel::CommandFor(double skyErrorDegrees) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		double gain = (achievedSkySum / achievedSquareSum) * (commandedAchievedSum / commandedSquareSum);
+		if (fabs(gain) < SKY_MODEL_MIN_GAIN)
+		{
+			gain = gain < 0.0 ? -1.0 : 1.0;
+		}
+		return skyErrorDegrees / gain;
+	}
+
+	void SkyModel::AddMove(double commanded, double achieved, double skyDelta)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		commandedAchievedSum += commanded * achieved;
+		commandedSquareSum += commanded * commanded;
+		achievedSkySum += achieved * skyDelta;
+		achievedSquareSum += achieved * achieved;
+	}
+
+	double SkyModel::SkyGain() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return achievedSkySum / achievedSquareSum;
+	}
+
+	double SkyModel::Efficiency() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return commandedAchievedSum / commandedSquareSum;
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,106 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_SKY_MODEL_H
+#define WANDERER_ROTATOR_SKY_MODEL_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - SKY MODEL
+ *
+ * Relation between the rotator's mechanical position and the sky position
+ * angle measured by a plate solver, learned across closed-loop corrections:
+ *
+ *   achieved rotation = efficiency * commanded rotation
+ *   sky change        = skyGain * achieved rotation
+ *   sky angle         = offset + skyGain * mechanical position
+ *
+ * skyGain is about +1 or -1 depending on the optical train's orientation.
+ * Both factors are least-squares ratios through the origin, seeded with a
+ * weak prior, so large moves dominate and solver noise on small
+ * corrections barely moves them.
+ * ============================================================================ */
+
+#include <mutex>
+
+namespace WandererRotator
+{
+	/**
+	 * Wrap an angle difference into [-180, 180) degrees.
+	 */
+	double WrapDegrees(double degrees);
+
+	class SkyModel
+	{
+	public:
+		/**
+		 * Forget everything learned, e.g. after the optical train changed.
+		 */
+		void Reset();
+
+		/**
+		 * Whether an offset has been anchored by a measurement.
+		 */
+		bool Anchored() const;
+
+		/**
+		 * Tie the model to a measurement: the sky angle at a mechanical position.
+		 */
+		void Anchor(double mechanicalDegrees, double skyDegrees);
+
+		/**
+		 * Predicted sky angle at a mechanical position, valid once anchored.
+		 */
+		double PredictSky(double mechanicalDegrees) const;
+
+		/**
+		 * Mechanical rotation to command for a sky angle error.
+		 */
+		double CommandFor(double skyErrorDegrees) const;
+
+		/**
+		 * Learn from one correction move between two measurements.
+		 * @param commanded Rotation commanded in degrees
+		 * @param achieved Rotation the device reported in degrees
+		 * @param skyDelta Change of the measured sky angle in degrees
+		 */
+		void AddMove(double commanded, double achieved, double skyDelta);
+
+		double SkyGain() const;
+		double Efficiency() const;
+
+	private:
+		mutable std::mutex mutex;
+		bool anchored = false;
+		double offset = 0.0;
+		/* Least-squares sums, seeded with the prior (gain 1) */
+		double achievedSkySum = SKY_MODEL_PRIOR_WEIGHT, achievedSquareSum = SKY_MODEL_PRIOR_WEIGHT;
+		double commandedAchievedSum = SKY_MODEL_PRIOR_WEIGHT, commandedSquareSum = SKY_MODEL_PRIOR_WEIGHT;
+
+		/* Prior weight in square degrees, that of a single 2 degree move */
+		static constexpr double SKY_MODEL_PRIOR_WEIGHT = 4.0;
+	};
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_SKY_MODEL_H */
@@ -0,0 +1,193 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorStats.h"
+#include <cmath>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * LATENCY HISTOGRAM
+	 * ============================================================================ */
+
+	constexpr double LatencyHistogram::BOUNDS_MS[];
+
+	/* Weight of older samples in the move-time fit, applied per new sample */
+	static constexpr double MOVE_MODEL_DECAY = 0.95;
+
+	/* Minimum step count spread (std dev) before the fitted slope is trusted */
+	static constexpr double MOVE_MODEL_MIN_SPREAD = 500.0;
+
+	void LatencyHistogram::Record(double ms)
+	{
+		int bucket = 0;
+		while (bucket < BUCKETS - 1 && ms > BOUNDS_MS[bucket])
+		{
+			bucket++;
+		}
+
+		buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+		sumUs.fetch_add((unsigned long long)(ms * 1000.0), std::memory_order_relaxed);
+		count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	double LatencyHistogram::Percentile(double pct) const
+	{
+		unsigned long long counts[BUCKETS];
+		unsigned long long total = 0;
+		for (int i = 0; i < BUCKETS; i++)
+		{
+			counts[i] = buckets[i].load(std::memory_order_relaxed);
+			total += counts[i];
+		}
+
+		if (total == 0)
+		{
+			return 0.0;
+		}
+
+		double rank = pct / 100.0 * total;
+		unsigned long long seen = 0;
+		for (int i = 0; i < BUCKETS; i++)
+		{
+			if (counts[i] == 0 || seen + counts[i] < rank)
+			{
+				seen += counts[i];
+				continue;
+			}
+
+			double lower = (i == 0) ? 0.0 : BOUNDS_MS[i - 1];
+			if (i == BUCKETS - 1)
+			{
+				/* Unbounded bucket, report its lower edge */
+				return lower;
+			}
+			double fraction = (rank - seen) / counts[i];
+			return lower + fraction * (BOUNDS_MS[i] - lower);
+		}
+
+		return BOUNDS_MS[BUCKETS - 2];
+	}
+
+	/* ============================================================================
+	 * MOVE TIME MODEL
+	 * ============================================================================ */
+
+	void MoveTimeModel::SetNominal(double stepsPerSecond, double overheadMs)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (stepsPerSecond > 0.0)
+		{
+			nominalStepRate = stepsPerSecond;
+		}
+		if (overheadMs >= 0.0)
+		{
+			nominalOverheadMs = overheadMs;
+		}
+	}
+
+	void MoveTimeModel::Add(int steps, double ms)
+	{
+		double x = std::abs(steps);
+		std::lock_guard<std::mutex> lock(mutex);
+		n = n * MOVE_MODEL_DECAY + 1.0;
+		sx = sx * MOVE_MODEL_DECAY + x;
+		sy = sy * MOVE_MODEL_DECAY + ms;
+		sxx = sxx * MOVE_MODEL_DECAY + x * x;
+		sxy = sxy * MOVE_MODEL_DECAY + x * ms;
+	}
+
+	/* Caller holds mutex */
+	bool MoveTimeModel::Fit(double *msPerStep, double *overheadMs) const
+	{
+		if (n < 2.0)
+		{
+			return false;
+		}
+
+		double variance = sxx / n - (sx / n) * (sx / n);
+		if (variance < MOVE_MODEL_MIN_SPREAD * MOVE_MODEL_MIN_SPREAD)
+		{
+			/* Moves all about the same size: keep the nominal overhead, fit the rate only */
+			if (sx <= 0.0)
+			{
+				return false;
+			}
+			double slope = (sy - n * nominalOverheadMs) / sx;
+			if (slope <= 0.0)
+			{
+				return false;
+			}
+			*msPerStep = slope;
+			*overheadMs = nominalOverheadMs;
+			return true;
+		}
+
+		double slope = (n * sxy - sx * sy) / (n * n * variance);
+		double intercept = (sy - slope * sx) / n;
+		if (slope <= 0.0)
+		{
+			return false;
+		}
+
+		*msPerStep = slope;
+		*overheadMs = intercept > 0.0 ? intercept : 0.0;
+		return true;
+	}
+
+	double MoveTimeModel::PredictMs(int steps) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		double msPerStep, overheadMs;
+		if (!Fit(&msPerStep, &overheadMs))
+		{
+			msPerStep = 1000.0 / nominalStepRate;
+			overheadMs = nominalOverheadMs;
+		}
+		return overheadMs + std::abs(steps) * msPerStep;
+	}
+
+	double MoveTimeModel::StepRate() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		double msPerStep, overheadMs;
+		if (!Fit(&msPerStep, &overheadMs))
+		{
+			return nominalStepRate;
+		}
+		return 1000.0 / msPerStep;
+	}
+
+	double MoveTimeModel::OverheadMs() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		double msPerStep, overheadMs;
+		if (!Fit(&msPerStep, &overheadMs))
+		{
+			return nominalOverheadMs;
+		}
+		return overheadMs;
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,138 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_STATS_H
+#define WANDERER_ROTATOR_STATS_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - STATISTICS MODULE
+ *
+ * Per-device counters, command latency histogram and a move-time model
+ * learned from completed moves. Updated from API calls and the move
+ * listener, read by WRRotatorGetStats() without any serial traffic.
+ * ============================================================================ */
+
+#include <atomic>
+#include <mutex>
+
+namespace WandererRotator
+{
+	/**
+	 * Fixed-bucket latency histogram. Recording is lock-free.
+	 */
+	class LatencyHistogram
+	{
+	public:
+		static constexpr int BUCKETS = 17;
+
+		/* Bucket upper bounds in milliseconds, the last bucket is unbounded */
+		static constexpr double BOUNDS_MS[BUCKETS - 1] = {
+			1, 2, 5, 10, 20, 50, 75, 100, 150, 200, 300, 500, 750, 1000, 2000, 5000};
+
+		void Record(double ms);
+
+		/**
+		 * Estimate a percentile by interpolating inside its bucket.
+		 * @param pct Percentile in [0, 100]
+		 * @return Latency in milliseconds, 0 if nothing was recorded
+		 */
+		double Percentile(double pct) const;
+
+		unsigned long long Count() const { return count.load(std::memory_order_relaxed); }
+		unsigned long long BucketCount(int bucket) const { return buckets[bucket].load(std::memory_order_relaxed); }
+		double SumMs() const { return sumUs.load(std::memory_order_relaxed) / 1000.0; }
+
+	private:
+		std::atomic<unsigned long long> buckets[BUCKETS] = {};
+		std::atomic<unsigned long long> count{0};
+		std::atomic<unsigned long long> sumUs{0};
+	};
+
+	/**
+	 * Move duration model: duration = overhead + steps / stepRate, fitted by
+	 * exponentially weighted least squares over completed move phases.
+	 * Falls back to nominal values until the fit has enough spread.
+	 */
+	class MoveTimeModel
+	{
+	public:
+		/**
+		 * Set the values used before enough moves have been observed.
+		 */
+		void SetNominal(double stepsPerSecond, double overheadMs);
+
+		/**
+		 * Add one completed move phase.
+		 * @param steps Absolute step count of the phase
+		 * @param ms Time from submission until completion feedback
+		 */
+		void Add(int steps, double ms);
+
+		/**
+		 * Predict the duration of a single move phase in milliseconds.
+		 */
+		double PredictMs(int steps) const;
+
+		/**
+		 * Current effective step rate in steps per second.
+		 */
+		double StepRate() const;
+
+		/**
+		 * Current fixed per-move overhead in milliseconds.
+		 */
+		double OverheadMs() const;
+
+	private:
+		bool Fit(double *msPerStep, double *overheadMs) const;
+
+		mutable std::mutex mutex;
+		double nominalStepRate = 5000.0;
+		double nominalOverheadMs = 300.0;
+		double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+	};
+
+	/**
+	 * Runtime statistics of one device.
+	 */
+	struct DeviceStats
+	{
+		std::atomic<unsigned int> commands{0};	  /* Commands and queries written */
+		std::atomic<unsigned int> moves{0};		  /* Move phases submitted */
+		std::atomic<unsigned int> movesFinished{0}; /* Moves completed or failed, all phases */
+		std::atomic<unsigned int> timeouts{0};	  /* Response fields that never arrived */
+		std::atomic<unsigned int> parseErrors{0}; /* Response fields that could not be parsed */
+		std::atomic<unsigned int> reconnects{0};  /* Opens after the first one */
+		std::atomic<unsigned int> opens{0};
+		std::atomic<int> lastMoveError{0};		  /* WR_ERROR_TYPE of the most recent move */
+		std::atomic<long long> moveStartUs{0};	  /* Submission time of the current move phase */
+		std::atomic<int> moveExpectedMs{0};		  /* Predicted duration of the remaining move */
+
+		LatencyHistogram latency; /* Query round trips */
+		MoveTimeModel moveModel;
+	};
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_STATS_H */
@@ -0,0 +1,172 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorThreads.h"
+#include "WandererRotatorLogging.h"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * THREAD POLICY IMPLEMENTATION
+	 * ============================================================================ */
+
+	/* Default thread names, at most 15 characters */
+	static const char *DEFAULT_THREAD_NAMES[WR_THREAD_CLASS_COUNT] = {
+		"wr-listener",
+		"wr-metrics",
+		"wr-notify",
+	};
+
+	static std::mutex g_policyMutex;
+	static WR_THREAD_POLICY g_policies[WR_THREAD_CLASS_COUNT];
+	static std::atomic<unsigned int> g_generations[WR_THREAD_CLASS_COUNT];
+
+	bool SetThreadPolicy(WR_THREAD_CLASS threadClass, const WR_THREAD_POLICY *policy)
+	{
+		if (threadClass < 0 || threadClass >= WR_THREAD_CLASS_COUNT)
+		{
+			return false;
+		}
+
+		switch (policy->policy)
+		{
+		case WR_SCHED_INHERIT:
+		case WR_SCHED_OTHER:
+			break;
+		case WR_SCHED_FIFO:
+		case WR_SCHED_RR:
+			if (policy->priority < sched_get_priority_min(SCHED_FIFO) ||
+				policy->priority > sched_get_priority_max(SCHED_FIFO))
+			{
+				return false;
+			}
+			break;
+		default:
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(g_policyMutex);
+		g_policies[threadClass] = *policy;
+		g_policies[threadClass].name[sizeof(policy->name) - 1] = '\0';
+		g_generations[threadClass].fetch_add(1, std::memory_order_release);
+		return true;
+	}
+
+	unsigned int ThreadPolicyGeneration(WR_THREAD_CLASS threadClass)
+	{
+		if (threadClass < 0 || threadClass >= WR_THREAD_CLASS_COUNT)
+		{
+			return 0;
+		}
+		return g_generations[threadClass].load(std::memory_order_acquire);
+	}
+
+	bool GetThreadPolicy(WR_THREAD_CLASS threadClass, WR_THREAD_POLICY *policy)
+	{
+		if (threadClass < 0 || threadClass >= WR_THREAD_CLASS_COUNT)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(g_policyMutex);
+		*policy = g_policies[threadClass];
+		return true;
+	}
+
+	void ApplyThreadPolicy(WR_THREAD_CLASS threadClass, bool reapply)
+	{
+		WR_THREAD_POLICY policy;
+		if (!GetThreadPolicy(threadClass, &policy))
+		{
+			return;
+		}
+
+		pthread_t self = pthread_self();
+
+		const char *name = policy.name[0] ? policy.name : DEFAULT_THREAD_NAMES[threadClass];
+		pthread_setname_np(self, name);
+
+		if (policy.cpuMask != 0)
+		{
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++)
+			{
+				if (policy.cpuMask & (1ULL << cpu))
+				{
+					CPU_SET(cpu, &cpus);
+				}
+			}
+
+			int err = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+			if (err != 0)
+			{
+				WR_ERROR("Thread %s: Failed to set CPU affinity (%s)", name, strerror(err));
+			}
+		}
+		else if (reapply)
+		{
+			/* Undo an earlier mask: back to the CPUs of the process' main thread */
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			if (sched_getaffinity(getpid(), sizeof(cpus), &cpus) == 0)
+			{
+				int err = pthread_setaffinity_np(self, sizeof(cpus), &cpus);
+				if (err != 0)
+				{
+					WR_ERROR("Thread %s: Failed to restore CPU affinity (%s)", name, strerror(err));
+				}
+			}
+		}
+
+		/* Inherited settings are gone once another policy was applied, fall back to the default class */
+		if (policy.policy != WR_SCHED_INHERIT || reapply)
+		{
+			int schedPolicy = SCHED_OTHER;
+			struct sched_param param;
+			memset(&param, 0, sizeof(param));
+
+			if (policy.policy == WR_SCHED_FIFO || policy.policy == WR_SCHED_RR)
+			{
+				schedPolicy = (policy.policy == WR_SCHED_FIFO) ? SCHED_FIFO : SCHED_RR;
+				param.sched_priority = policy.priority;
+			}
+
+			int err = pthread_setschedparam(self, schedPolicy, &param);
+			if (err != 0)
+			{
+				/* Typically EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO grant */
+				WR_ERROR("Thread %s: Failed to set scheduling policy (%s)", name, strerror(err));
+			}
+		}
+	}
+
+} /* namespace WandererRotator */
@@ -0,0 +1,71 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_THREADS_H
+#define WANDERER_ROTATOR_THREADS_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - THREADS MODULE
+ *
+ * Scheduling policy, CPU affinity and names for threads created by the SDK.
+ * ============================================================================ */
+
+#include "WandererRotatorSDK.h"
+
+namespace WandererRotator
+{
+	/**
+	 * Store the policy for a thread class. Threads of that class started
+	 * afterwards apply it on entry, long-lived ones when they see the
+	 * generation change.
+	 * @return false if the class or policy is invalid
+	 */
+	bool SetThreadPolicy(WR_THREAD_CLASS threadClass, const WR_THREAD_POLICY *policy);
+
+	/**
+	 * Counter bumped by every SetThreadPolicy() for the class, so a
+	 * long-lived thread can tell cheaply whether to re-apply its policy.
+	 */
+	unsigned int ThreadPolicyGeneration(WR_THREAD_CLASS threadClass);
+
+	/**
+	 * Read the policy stored for a thread class.
+	 */
+	bool GetThreadPolicy(WR_THREAD_CLASS threadClass, WR_THREAD_POLICY *policy);
+
+	/**
+	 * Apply the stored policy and name to the calling thread.
+	 * Must be the first thing an SDK thread does. Failures are logged and
+	 * the thread continues with its inherited settings.
+	 *
+	 * @param reapply true when a running thread picks up a changed policy:
+	 *                a zero CPU mask then restores the process' affinity and
+	 *                WR_SCHED_INHERIT falls back to WR_SCHED_OTHER, so an
+	 *                earlier policy is undone rather than kept
+	 */
+	void ApplyThreadPolicy(WR_THREAD_CLASS threadClass, bool reapply = false);
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_THREADS_H */
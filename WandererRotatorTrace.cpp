@@ -0,0 +1,125 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#include "WandererRotatorTrace.h"
+#include "WandererRotatorLogging.h"
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+namespace WandererRotator
+{
+	/* ============================================================================
+	 * TRACE IMPLEMENTATION
+	 * ============================================================================ */
+
+	static std::mutex g_traceMutex;
+	static FILE *g_traceFile = nullptr;
+	static std::atomic<bool> g_traceEnabled{false};
+
+	long long TraceNowUs()
+	{
+		auto now = std::chrono::steady_clock::now().time_since_epoch();
+		return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+	}
+
+	const char *TraceData(const unsigned char *data, int len, char *out, int outLen)
+	{
+		int n = 0;
+		for (int i = 0; i < len && n < outLen - 1; i++)
+		{
+			out[n++] = isgraph(data[i]) ? (char)data[i] : '.';
+		}
+		out[n] = '\0';
+		return out;
+	}
+
+	bool TraceOpen(const char *path)
+	{
+		std::lock_guard<std::mutex> lock(g_traceMutex);
+
+		g_traceEnabled = false;
+		if (g_traceFile)
+		{
+			fclose(g_traceFile);
+			g_traceFile = nullptr;
+		}
+
+		if (!path || !path[0])
+		{
+			return true;
+		}
+
+		g_traceFile = fopen(path, "a");
+		if (!g_traceFile)
+		{
+			WR_ERROR("TraceOpen: Failed to open trace file %s", path);
+			return false;
+		}
+
+		/* Line buffered so a crash loses at most the record being written */
+		setvbuf(g_traceFile, nullptr, _IOLBF, 0);
+		g_traceEnabled = true;
+		return true;
+	}
+
+	bool TraceEnabled()
+	{
+		static const bool envChecked = []()
+		{
+			const char *path = getenv("WR_TRACE_FILE");
+			if (path && path[0])
+			{
+				TraceOpen(path);
+			}
+			return true;
+		}();
+		(void)envChecked;
+
+		return g_traceEnabled.load(std::memory_order_relaxed);
+	}
+
+	void TraceWrite(const char *port, const char *kind, const char *fmt, ...)
+	{
+		long long now = TraceNowUs();
+
+		std::lock_guard<std::mutex> lock(g_traceMutex);
+		if (!g_traceFile)
+		{
+			return;
+		}
+
+		va_list args;
+		va_start(args, fmt);
+		fprintf(g_traceFile, "%lld %s %s ", now, port && port[0] ? port : "-", kind);
+		vfprintf(g_traceFile, fmt, args);
+		fputc('\n', g_traceFile);
+		va_end(args);
+	}
+
+} /* namespace WandererRotator */
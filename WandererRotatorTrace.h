@@ -0,0 +1,96 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+#ifndef WANDERER_ROTATOR_TRACE_H
+#define WANDERER_ROTATOR_TRACE_H
+
+/* ============================================================================
+ * WANDERER ROTATOR SDK - TRACE MODULE
+ *
+ * Runtime-enabled capture of serial traffic and timing for post-mortem
+ * analysis with the wrtrace tool. Tracing is off unless a trace file is set
+ * through WRSetTraceFile() or the WR_TRACE_FILE environment variable.
+ *
+ * Each record is one line:
+ *   <monotonic microseconds> <port> <KIND> [key=value ...]
+ * ============================================================================ */
+
+namespace WandererRotator
+{
+	/* Trace record kinds */
+	static constexpr const char *WR_TRACE_TX = "TX";			  /* Bytes written: data=<command> */
+	static constexpr const char *WR_TRACE_RX = "RX";			  /* Field read: data=<field> us=<read time> */
+	static constexpr const char *WR_TRACE_TIMEOUT = "TIMEOUT";	  /* Read without delimiter: us=<waited> data=<partial> */
+	static constexpr const char *WR_TRACE_PARSE = "PARSE";		  /* Unparseable field: ctx=<where> data=<raw> */
+	static constexpr const char *WR_TRACE_RTT = "RTT";			  /* Query round trip: type=<command type> us=<time> */
+	static constexpr const char *WR_TRACE_MOVE = "MOVE";		  /* Move submitted: steps=<n> phase=<0|1|2> */
+	static constexpr const char *WR_TRACE_DONE = "DONE";		  /* Move finished: rotated=<deg> position=<mdeg> phase=<0|1|2> */
+	static constexpr const char *WR_TRACE_LOCK = "LOCK";		  /* Device lock acquired: site=<function> us=<wait> */
+
+	/**
+	 * Open a trace file for appending, replacing any trace file already open.
+	 * @param path File path, or nullptr to stop tracing
+	 * @return true if tracing is now in the requested state
+	 */
+	bool TraceOpen(const char *path);
+
+	/**
+	 * Check whether tracing is enabled. Cheap enough for hot paths.
+	 * The WR_TRACE_FILE environment variable is honoured on first call.
+	 */
+	bool TraceEnabled();
+
+	/**
+	 * Append one trace record stamped with the current monotonic time.
+	 * @param port Port name the record refers to ("-" if none)
+	 * @param kind One of the WR_TRACE_* kinds
+	 */
+	void TraceWrite(const char *port, const char *kind, const char *fmt, ...)
+		__attribute__((format(printf, 3, 4)));
+
+	/**
+	 * Monotonic clock in microseconds, the time base of all trace records.
+	 */
+	long long TraceNowUs();
+
+	/**
+	 * Copy raw serial bytes into a single printable token for a trace record.
+	 * Whitespace and non-printable bytes are replaced with '.'.
+	 * @return out
+	 */
+	const char *TraceData(const unsigned char *data, int len, char *out, int outLen);
+
+/* Trace macro - arguments are only evaluated when tracing is enabled */
+#define WR_TRACE(port, kind, fmt, ...)                                      \
+	do                                                                      \
+	{                                                                       \
+		if (WandererRotator::TraceEnabled())                                \
+		{                                                                   \
+			WandererRotator::TraceWrite(port, kind, fmt, ##__VA_ARGS__);    \
+		}                                                                   \
+	} while (0)
+
+} /* namespace WandererRotator */
+
+#endif /* WANDERER_ROTATOR_TRACE_H */
@@ -0,0 +1,326 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+/* ============================================================================
+ * test_allocations - steady-state allocation check
+ *
+ * Drives a simulated rotator on a pseudo terminal through moves, status
+ * polls, event callbacks and notifications, and fails if the SDK allocates
+ * heap memory once it is warmed up. malloc, calloc and realloc are
+ * interposed, so every allocation in the process is seen.
+ *
+ * Usage: test_allocations       (no hardware needed)
+ * ============================================================================ */
+
+#include "WandererRotatorSDK.h"
+#include "WandererRotatorDevice.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+/* ============================================================================
+ * ALLOCATION COUNTING
+ * ============================================================================ */
+
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+static std::atomic<bool> g_counting{false};
+static std::atomic<long> g_allocations{0};
+
+extern "C" void *malloc(size_t size)
+{
+	if (g_counting.load(std::memory_order_relaxed))
+		g_allocations++;
+	return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+	if (g_counting.load(std::memory_order_relaxed))
+		g_allocations++;
+	return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+	if (g_counting.load(std::memory_order_relaxed))
+		g_allocations++;
+	return __libc_realloc(ptr, size);
+}
+
+/* ============================================================================
+ * SIMULATED ROTATOR
+ *
+ * Answers status queries and moves like a WandererRotatorLite. Runs in this
+ * process while allocations are counted, so it only uses fixed buffers.
+ * ============================================================================ */
+
+static const int SIM_STEPS_PER_DEGREE = 1155;
+static const double SIM_STEP_RATE = 50000.0; /* Steps per second */
+
+struct Simulator
+{
+	int master = -1;
+	int slave = -1; /* Held open so the master never sees a hangup */
+	char path[64] = "";
+	int position = 10000; /* Millidegrees */
+	int backlash = 5;	  /* Tenths of a degree */
+	int reverse = 0;
+	std::atomic<bool> stop{false};
+	std::thread thread;
+
+	bool Start()
+	{
+		master = posix_openpt(O_RDWR | O_NOCTTY);
+		if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0 ||
+			ptsname_r(master, path, sizeof(path)) != 0)
+			return false;
+
+		slave = open(path, O_RDWR | O_NOCTTY);
+		if (slave < 0)
+			return false;
+
+		struct termios raw;
+		tcgetattr(slave, &raw);
+		cfmakeraw(&raw);
+		tcsetattr(slave, TCSANOW, &raw);
+
+		thread = std::thread(&Simulator::Run, this);
+		return true;
+	}
+
+	void Stop()
+	{
+		stop = true;
+		if (thread.joinable())
+			thread.join();
+		close(slave);
+		close(master);
+	}
+
+	void Reply(const char *text)
+	{
+		if (write(master, text, strlen(text)) < 0)
+			perror("simulator write");
+	}
+
+	void Handle(const char *command)
+	{
+		char reply[96];
+		long value = atol(command);
+
+		if (strcmp(command, "1500001") == 0)
+		{
+			snprintf(reply, sizeof(reply), "WandererRotatorLiteA20240101A%dA%d.%dA%dA",
+					 position, backlash / 10, backlash % 10, reverse);
+			Reply(reply);
+		}
+		else if (strcmp(command, "1500002") == 0)
+		{
+			position = 0;
+		}
+		else if (value >= 1700000 && value < 1800000)
+		{
+			reverse = (int)(value % 10);
+		}
+		else if (value >= 1600000 && value < 1700000)
+		{
+			backlash = (int)(value - 1600000);
+		}
+		else if (value > 0 && value < 1500000)
+		{
+			int steps = (int)(value - 1000000);
+			usleep((useconds_t)(50000 + abs(steps) * 1000000.0 / SIM_STEP_RATE));
+			double degrees = (double)steps / SIM_STEPS_PER_DEGREE;
+			position = (int)(((lround(position + degrees * 1000.0) % 360000) + 360000) % 360000);
+			snprintf(reply, sizeof(reply), "%.2fA%dA", degrees, position);
+			Reply(reply);
+		}
+		/* "stop" needs no answer */
+	}
+
+	void Run()
+	{
+		char line[64];
+		size_t used = 0;
+
+		/* Commands are not terminated, the line going idle ends one */
+		while (!stop)
+		{
+			struct pollfd fds = {master, POLLIN, 0};
+			char c;
+			if (poll(&fds, 1, 20) > 0 && read(master, &c, 1) == 1)
+			{
+				if (c != '\n' && c != '\r' && used < sizeof(line) - 1)
+					line[used++] = c;
+				continue;
+			}
+
+			if (used > 0)
+			{
+				line[used] = '\0';
+				Handle(line);
+				used = 0;
+			}
+		}
+	}
+};
+
+/* ============================================================================
+ * TEST
+ * ============================================================================ */
+
+static std::atomic<int> g_events{0};
+static std::atomic<int> g_notifications{0};
+
+static void OnEvent(const WR_EVENT *event, void *context)
+{
+	(void)event;
+	(void)context;
+	g_events++;
+}
+
+static void OnNotification(const WR_NOTIFICATION *notification, void *context)
+{
+	(void)notification;
+	(void)context;
+	g_notifications++;
+}
+
+static bool WaitIdle(int id)
+{
+	WR_ROTATOR_STATUS status;
+	for (int i = 0; i < 1500; i++)
+	{
+		usleep(20000);
+		if (WRRotatorGetStatus(id, &status) != WR_SUCCESS)
+			return false;
+		if (!status.moving)
+			return true;
+	}
+	return false;
+}
+
+/* Moves, polls and a stop, the way a capture sequence uses the SDK */
+static bool RunSequence(int id)
+{
+	const float targets[] = {20.0f, 10.0f, 30.0f, 0.0f};
+	for (float target : targets)
+	{
+		if (WRRotatorMoveTo(id, target) != WR_SUCCESS || !WaitIdle(id))
+			return false;
+	}
+
+	WR_ROTATOR_STATS stats;
+	if (WRRotatorMove(id, 3.0f) != WR_SUCCESS || WRRotatorGetStats(id, &stats) != WR_SUCCESS)
+		return false;
+	usleep(20000);
+	if (WRRotatorStopMove(id) != WR_SUCCESS)
+		return false;
+
+	/* Let the feedback of the stopped move arrive before the next phase */
+	usleep(300000);
+	return WaitIdle(id);
+}
+
+int main()
+{
+	printf("=== Wanderer Rotator Steady-State Allocation Test ===\n\n");
+
+	Simulator sim;
+	if (!sim.Start())
+	{
+		printf("[FAIL] Cannot create a pseudo terminal\n");
+		return 1;
+	}
+
+	/* Register the simulated port directly, a scan only finds USB rotators */
+	const int id = 0;
+	{
+		auto device = std::make_shared<WandererRotator::Device>();
+		device->portName = sim.path;
+		device->id = id;
+		auto devices = std::make_shared<WandererRotator::DeviceTable>();
+		devices->Set(id, device);
+		WandererRotator::PublishDevices(devices);
+	}
+
+	WR_ERROR_TYPE result = WRRotatorOpen(id);
+	if (result != WR_SUCCESS)
+	{
+		printf("[FAIL] Cannot open simulated rotator on %s (Error: %d)\n", sim.path, result);
+		sim.Stop();
+		return 1;
+	}
+
+	WR_SUBSCRIPTION subscription = {WR_NOTIFY_POSITION | WR_NOTIFY_MOVING, 0, 0};
+	int handle = -1;
+	if (WRRotatorSetEventCallback(id, OnEvent, NULL) != WR_SUCCESS ||
+		WRRotatorSubscribe(id, &subscription, OnNotification, NULL, &handle) != WR_SUCCESS)
+	{
+		printf("[FAIL] Cannot register callbacks\n");
+		WRRotatorClose(id);
+		sim.Stop();
+		return 1;
+	}
+
+	/* Warm up: first-use allocations (threads, buffers, statics) are allowed */
+	bool ok = RunSequence(id);
+
+	g_counting = true;
+	ok = ok && RunSequence(id);
+	g_counting = false;
+
+	long allocations = g_allocations;
+
+	WRUnsubscribe(handle);
+	WRRotatorClose(id);
+	sim.Stop();
+
+	if (!ok)
+	{
+		printf("[FAIL] Simulated move sequence did not complete\n");
+		return 1;
+	}
+
+	printf("Events: %d, notifications: %d\n", g_events.load(), g_notifications.load());
+	if (allocations != 0)
+	{
+		printf("[FAIL] %ld heap allocation(s) in steady state\n", allocations);
+		return 1;
+	}
+
+	printf("[PASS] No heap allocations in steady state\n");
+	return 0;
+}
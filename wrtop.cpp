@@ -0,0 +1,417 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+/* ============================================================================
+ * wrtop - live terminal dashboard for Wanderer Rotators
+ *
+ * Polls the OpenMetrics endpoint of a running SDK (see WRStartMetricsServer())
+ * and redraws its per-device counters, gauges and latency percentiles. wrtop
+ * never opens a serial port, so it can watch an application that owns the
+ * rotators without disturbing it.
+ *
+ * Usage: wrtop [-r hz] endpoint     ("unix:/path", "host:port" or ":port")
+ * Keys:  q quit
+ * ============================================================================ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <termios.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct RotatorRow
+{
+	std::string port;
+	std::string model;
+	double position = 0.0;
+	bool moving = false;
+	int phase = 0;		 /* 0 plain move, 1 overshoot out, 2 overshoot return */
+	double etaS = 0.0;
+	int lastMoveError = 0;
+	double stepRate = 0.0;
+	unsigned long long commands = 0;
+	unsigned long long moves = 0;
+	unsigned long long timeouts = 0;
+	unsigned long long parseErrors = 0;
+	unsigned long long reconnects = 0;
+	std::vector<std::pair<double, unsigned long long>> latency; /* (upper bound in s, cumulative count) */
+};
+
+static struct termios g_savedTerm;
+
+static void RestoreTerminal()
+{
+	tcsetattr(STDIN_FILENO, TCSANOW, &g_savedTerm);
+	printf("\033[?25h\n"); /* Show cursor */
+}
+
+static void SetupTerminal()
+{
+	tcgetattr(STDIN_FILENO, &g_savedTerm);
+	struct termios raw = g_savedTerm;
+	raw.c_lflag &= ~(ICANON | ECHO);
+	raw.c_cc[VMIN] = 0;
+	raw.c_cc[VTIME] = 0;
+	tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+	atexit(RestoreTerminal);
+	printf("\033[?25l"); /* Hide cursor */
+}
+
+/* ============================================================================
+ * ENDPOINT ACCESS
+ * ============================================================================ */
+
+static int ConnectEndpoint(const char *endpoint)
+{
+	if (strncmp(endpoint, "unix:", 5) == 0)
+	{
+		const char *path = endpoint + 5;
+		struct sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		if (!path[0] || strlen(path) >= sizeof(addr.sun_path))
+			return -1;
+		strcpy(addr.sun_path, path);
+
+		int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+		if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+		{
+			close(fd);
+			fd = -1;
+		}
+		return fd;
+	}
+
+	const char *colon = strrchr(endpoint, ':');
+	if (!colon)
+		return -1;
+
+	char *end = NULL;
+	long port = strtol(colon + 1, &end, 10);
+	if (end == colon + 1 || *end != '\0' || port <= 0 || port > 65535)
+		return -1;
+
+	std::string host(endpoint, colon - endpoint);
+	if (host.empty() || host == "localhost")
+		host = "127.0.0.1";
+
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons((unsigned short)port);
+	if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1)
+		return -1;
+
+	int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+	{
+		close(fd);
+		fd = -1;
+	}
+	return fd;
+}
+
+/* Fetch /metrics and return the body, empty on any failure */
+static std::string FetchMetrics(const char *endpoint)
+{
+	int fd = ConnectEndpoint(endpoint);
+	if (fd < 0)
+		return std::string();
+
+	struct timeval tv = {1, 0};
+	setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+	const char request[] = "GET /metrics HTTP/1.0\r\nHost: localhost\r\n\r\n";
+	if (send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL) != (ssize_t)(sizeof(request) - 1))
+	{
+		close(fd);
+		return std::string();
+	}
+
+	/* The server closes the connection after the response */
+	std::string response;
+	char buffer[4096];
+	ssize_t n;
+	while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+		response.append(buffer, n);
+	close(fd);
+
+	if (response.compare(0, 12, "HTTP/1.0 200") != 0 && response.compare(0, 12, "HTTP/1.1 200") != 0)
+		return std::string();
+
+	size_t body = response.find("\r\n\r\n");
+	return body == std::string::npos ? std::string() : response.substr(body + 4);
+}
+
+/* ============================================================================
+ * OPENMETRICS PARSING
+ * ============================================================================ */
+
+/* Parse 'name{k="v",...} value', returns false for comments and malformed lines */
+static bool ParseSample(const std::string &line, std::string &name, std::map<std::string, std::string> &labels,
+						double &value)
+{
+	if (line.empty() || line[0] == '#')
+		return false;
+
+	size_t pos = line.find_first_of("{ ");
+	if (pos == std::string::npos)
+		return false;
+	name = line.substr(0, pos);
+	labels.clear();
+
+	if (line[pos] == '{')
+	{
+		pos++;
+		while (pos < line.size() && line[pos] != '}')
+		{
+			size_t eq = line.find("=\"", pos);
+			if (eq == std::string::npos)
+				return false;
+			std::string key = line.substr(pos, eq - pos);
+			std::string val;
+			for (pos = eq + 2; pos < line.size() && line[pos] != '"'; pos++)
+			{
+				if (line[pos] == '\\' && pos + 1 < line.size())
+				{
+					pos++;
+					val += (line[pos] == 'n') ? '\n' : line[pos];
+				}
+				else
+				{
+					val += line[pos];
+				}
+			}
+			if (pos >= line.size())
+				return false;
+			labels[key] = val;
+			pos++;
+			if (pos < line.size() && line[pos] == ',')
+				pos++;
+		}
+		if (pos >= line.size())
+			return false;
+		pos++;
+	}
+
+	char *end = NULL;
+	value = strtod(line.c_str() + pos, &end);
+	return end != line.c_str() + pos;
+}
+
+static std::map<int, RotatorRow> ParseMetrics(const std::string &body)
+{
+	std::map<int, RotatorRow> rows;
+	std::map<std::string, std::string> labels;
+	std::string name;
+	double value;
+	size_t start = 0;
+
+	while (start < body.size())
+	{
+		size_t end = body.find('\n', start);
+		if (end == std::string::npos)
+			end = body.size();
+		std::string line = body.substr(start, end - start);
+		start = end + 1;
+
+		if (!ParseSample(line, name, labels, value) || labels.find("id") == labels.end())
+			continue;
+
+		RotatorRow &row = rows[atoi(labels["id"].c_str())];
+		row.port = labels["port"];
+		row.model = labels["model"];
+
+		if (name == "wr_rotator_position_degrees")
+			row.position = value;
+		else if (name == "wr_rotator_moving")
+			row.moving = value != 0.0;
+		else if (name == "wr_rotator_move_phase")
+			row.phase = (int)value;
+		else if (name == "wr_rotator_move_eta_seconds")
+			row.etaS = value;
+		else if (name == "wr_rotator_last_move_error")
+			row.lastMoveError = (int)value;
+		else if (name == "wr_rotator_step_rate")
+			row.stepRate = value;
+		else if (name == "wr_rotator_commands_total")
+			row.commands = (unsigned long long)value;
+		else if (name == "wr_rotator_moves_total")
+			row.moves = (unsigned long long)value;
+		else if (name == "wr_rotator_timeouts_total")
+			row.timeouts = (unsigned long long)value;
+		else if (name == "wr_rotator_parse_errors_total")
+			row.parseErrors = (unsigned long long)value;
+		else if (name == "wr_rotator_reconnects_total")
+			row.reconnects = (unsigned long long)value;
+		else if (name == "wr_rotator_query_latency_seconds_bucket")
+		{
+			const std::string &le = labels["le"];
+			double bound = (le == "+Inf") ? -1.0 : atof(le.c_str());
+			row.latency.push_back(std::make_pair(bound, (unsigned long long)value));
+		}
+	}
+	return rows;
+}
+
+static const char *PhaseName(const RotatorRow &row)
+{
+	if (!row.moving)
+		return "idle";
+	switch (row.phase)
+	{
+	case 1:
+		return "overshoot";
+	case 2:
+		return "return";
+	default:
+		return "moving";
+	}
+}
+
+/* Estimate a percentile in milliseconds by interpolating inside its bucket */
+static double Percentile(const RotatorRow &row, double pct)
+{
+	if (row.latency.empty() || row.latency.back().second == 0)
+		return 0.0;
+
+	double rank = pct / 100.0 * row.latency.back().second;
+	double lower = 0.0;
+	unsigned long long below = 0;
+	for (const auto &bucket : row.latency)
+	{
+		if (bucket.second >= rank && bucket.second > below)
+		{
+			if (bucket.first < 0.0)
+				return lower * 1000.0; /* Unbounded bucket, report its lower edge */
+			double fraction = (rank - below) / (double)(bucket.second - below);
+			return (lower + (bucket.first - lower) * fraction) * 1000.0;
+		}
+		if (bucket.first >= 0.0)
+			lower = bucket.first;
+		below = bucket.second;
+	}
+	return lower * 1000.0;
+}
+
+static void Draw(const char *endpoint, const std::map<int, RotatorRow> &rows, bool reachable, double hz)
+{
+	printf("\033[H\033[2J");
+	printf("wrtop - %s, %zu rotator(s), %.0f Hz   [q]uit\n\n", endpoint, rows.size(), hz);
+	if (!reachable)
+	{
+		printf("  (endpoint unreachable)\n");
+		fflush(stdout);
+		return;
+	}
+
+	printf("%3s %-14s %-7s %9s %-9s %7s %4s %7s %7s %7s %8s %6s %5s %5s %6s %8s\n",
+		   "ID", "PORT", "MODEL", "POS", "PHASE", "ETA(s)", "ERR", "P50ms", "P90ms", "P99ms",
+		   "COMMANDS", "MOVES", "TMO", "PARSE", "RECONN", "STEPS/s");
+
+	for (const auto &entry : rows)
+	{
+		const RotatorRow &row = entry.second;
+		printf("%3d %-14s %-7s %9.3f %-9s %7.1f %4d %7.1f %7.1f %7.1f %8llu %6llu %5llu %5llu %6llu %8.0f\n",
+			   entry.first, row.port.c_str(), row.model.c_str(), row.position, PhaseName(row), row.etaS,
+			   row.lastMoveError, Percentile(row, 50), Percentile(row, 90), Percentile(row, 99),
+			   row.commands, row.moves, row.timeouts, row.parseErrors, row.reconnects, row.stepRate);
+	}
+	fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+	double hz = 2.0;
+	const char *endpoint = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+		{
+			hz = atof(argv[++i]);
+			if (hz <= 0.0)
+				hz = 2.0;
+		}
+		else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+		{
+			printf("Usage: %s [-r hz] endpoint     (\"unix:/path\", \"host:port\" or \":port\")\n", argv[0]);
+			return 0;
+		}
+		else
+		{
+			endpoint = argv[i];
+		}
+	}
+
+	if (!endpoint)
+	{
+		fprintf(stderr, "Usage: %s [-r hz] endpoint\n", argv[0]);
+		return 1;
+	}
+
+	/* Fail early on a bad endpoint rather than drawing an empty screen */
+	std::string body = FetchMetrics(endpoint);
+	if (body.empty())
+	{
+		fprintf(stderr, "Cannot read metrics from %s\n", endpoint);
+		return 1;
+	}
+
+	SetupTerminal();
+
+	bool running = true;
+	int periodUs = (int)(1000000.0 / hz);
+
+	while (running)
+	{
+		Draw(endpoint, ParseMetrics(body), !body.empty(), hz);
+
+		fd_set readfds;
+		FD_ZERO(&readfds);
+		FD_SET(STDIN_FILENO, &readfds);
+		struct timeval tv = {periodUs / 1000000, periodUs % 1000000};
+		if (select(STDIN_FILENO + 1, &readfds, NULL, NULL, &tv) > 0)
+		{
+			char key;
+			if (read(STDIN_FILENO, &key, 1) == 1 && key == 'q')
+				running = false;
+		}
+
+		if (running)
+			body = FetchMetrics(endpoint);
+	}
+
+	return 0;
+}
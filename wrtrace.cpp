@@ -0,0 +1,403 @@
+/* *******************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025 Nico Trost
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * **************************************************************************** */
+
+/* ============================================================================
+ * wrtrace - offline analyzer for Wanderer Rotator SDK traces
+ *
+ * Reads trace files written by the SDK (see WRSetTraceFile() / WR_TRACE_FILE)
+ * and reports latency distributions, effective step rate, overshoot phase
+ * gaps, timeouts, parse errors and lock waits. SDK stderr logs may be fed in
+ * as well; their WR_WARN timeout and parse error lines are counted.
+ *
+ * Usage: wrtrace [-p port] [file ...]     (reads stdin without files)
+ * ============================================================================ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+struct PendingMove
+{
+	long long ts = 0;
+	int steps = 0;
+	int phase = 0;
+	bool active = false;
+};
+
+struct PortState
+{
+	PendingMove move;
+	long long phaseOneDone = -1; /* Timestamp of the last overshoot phase 1 completion */
+};
+
+struct Analysis
+{
+	long long records = 0;
+	long long firstTs = -1;
+	long long lastTs = -1;
+	std::map<std::string, PortState> ports;
+	std::map<std::string, std::vector<double>> latencyMs;	/* Per command type */
+	std::map<std::string, long long> commandsSent;			/* Per command type */
+	std::vector<std::pair<double, double>> moveSamples;	/* (steps, duration ms) */
+	std::vector<double> phaseGapsMs;
+	std::map<std::string, long long> timeouts;				/* Per port */
+	double timeoutWaitMs = 0.0;
+	std::map<std::string, long long> parseErrors;			/* Per context */
+	std::map<std::string, std::vector<double>> lockWaitsMs; /* Per API call site */
+	long long logTimeouts = 0;
+	long long logParseErrors = 0;
+};
+
+/* Find "key=" in a record and return its value, or nullptr */
+static const char *FindField(const char *rest, const char *key, char *value, size_t valueLen)
+{
+	size_t keyLen = strlen(key);
+	const char *p = rest;
+	while (p && *p)
+	{
+		while (*p == ' ')
+			p++;
+		if (strncmp(p, key, keyLen) == 0 && p[keyLen] == '=')
+		{
+			p += keyLen + 1;
+			size_t n = strcspn(p, " \n");
+			if (n >= valueLen)
+				n = valueLen - 1;
+			memcpy(value, p, n);
+			value[n] = '\0';
+			return value;
+		}
+		p = strchr(p, ' ');
+	}
+	return nullptr;
+}
+
+static const char *CommandType(const char *data)
+{
+	if (strncmp(data, "1500001", 7) == 0)
+		return "status";
+	if (strncmp(data, "1500002", 7) == 0)
+		return "sync";
+	if (strncmp(data, "stop", 4) == 0)
+		return "stop";
+	if (strncmp(data, "17", 2) == 0)
+		return "reverse";
+	if (strncmp(data, "16", 2) == 0)
+		return "backlash";
+	return "move";
+}
+
+static double Percentile(std::vector<double> &values, double pct)
+{
+	if (values.empty())
+		return 0.0;
+	std::sort(values.begin(), values.end());
+	size_t rank = (size_t)ceil(pct / 100.0 * values.size());
+	if (rank == 0)
+		rank = 1;
+	return values[rank - 1];
+}
+
+static void ParseLogLine(Analysis &a, const char *line)
+{
+	/* Every timeout and parse error is logged once at warning level; debug
+	 * builds add context lines about the same failures, don't count those.
+	 */
+	if (!strstr(line, "[WR_") || strstr(line, "[WR_DEBUG]"))
+		return;
+	if (strstr(line, "timeout") || strstr(line, "Timeout") || strstr(line, "timed out"))
+		a.logTimeouts++;
+	else if (strstr(line, "nvalid message"))
+		a.logParseErrors++;
+}
+
+static void ParseRecord(Analysis &a, const char *line, const char *portFilter)
+{
+	long long ts;
+	char port[128];
+	char kind[16];
+	int consumed = 0;
+
+	if (sscanf(line, "%lld %127s %15s %n", &ts, port, kind, &consumed) != 3)
+	{
+		ParseLogLine(a, line);
+		return;
+	}
+
+	if (portFilter && strcmp(port, "-") != 0 && strcmp(port, portFilter) != 0)
+		return;
+
+	const char *rest = line + consumed;
+	char value[64];
+	char type[32];
+
+	a.records++;
+	if (a.firstTs < 0)
+		a.firstTs = ts;
+	a.lastTs = ts;
+
+	PortState &state = a.ports[port];
+
+	if (strcmp(kind, "TX") == 0)
+	{
+		if (FindField(rest, "data", value, sizeof(value)))
+			a.commandsSent[CommandType(value)]++;
+	}
+	else if (strcmp(kind, "RTT") == 0)
+	{
+		if (FindField(rest, "type", type, sizeof(type)) && FindField(rest, "us", value, sizeof(value)))
+			a.latencyMs[type].push_back(atoll(value) / 1000.0);
+	}
+	else if (strcmp(kind, "MOVE") == 0)
+	{
+		state.move.active = true;
+		state.move.ts = ts;
+		state.move.steps = FindField(rest, "steps", value, sizeof(value)) ? atoi(value) : 0;
+		state.move.phase = FindField(rest, "phase", value, sizeof(value)) ? atoi(value) : 0;
+
+		if (state.move.phase == 2 && state.phaseOneDone >= 0)
+		{
+			a.phaseGapsMs.push_back((ts - state.phaseOneDone) / 1000.0);
+			state.phaseOneDone = -1;
+		}
+	}
+	else if (strcmp(kind, "DONE") == 0)
+	{
+		if (state.move.active)
+		{
+			double durationMs = (ts - state.move.ts) / 1000.0;
+			a.latencyMs["move"].push_back(durationMs);
+			a.moveSamples.push_back({(double)abs(state.move.steps), durationMs});
+			state.move.active = false;
+		}
+
+		int phase = FindField(rest, "phase", value, sizeof(value)) ? atoi(value) : 0;
+		state.phaseOneDone = (phase == 1) ? ts : -1;
+	}
+	else if (strcmp(kind, "TIMEOUT") == 0)
+	{
+		a.timeouts[port]++;
+		if (FindField(rest, "us", value, sizeof(value)))
+			a.timeoutWaitMs += atoll(value) / 1000.0;
+
+		/* A move whose feedback timed out has no usable duration */
+		state.move.active = false;
+	}
+	else if (strcmp(kind, "PARSE") == 0)
+	{
+		a.parseErrors[FindField(rest, "ctx", value, sizeof(value)) ? value : "?"]++;
+	}
+	else if (strcmp(kind, "LOCK") == 0)
+	{
+		if (FindField(rest, "site", type, sizeof(type)) && FindField(rest, "us", value, sizeof(value)))
+			a.lockWaitsMs[type].push_back(atoll(value) / 1000.0);
+	}
+}
+
+static void PrintDistribution(const char *name, std::vector<double> &values)
+{
+	double maxValue = values.empty() ? 0.0 : *std::max_element(values.begin(), values.end());
+	printf("  %-12s %7zu %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, values.size(),
+		   Percentile(values, 0.0), Percentile(values, 50.0), Percentile(values, 90.0),
+		   Percentile(values, 99.0), maxValue);
+}
+
+static void PrintMoveRegression(const std::vector<std::pair<double, double>> &samples)
+{
+	printf("\nMove duration vs step count\n");
+	printf("===========================\n");
+
+	size_t n = samples.size();
+	if (n < 2)
+	{
+		printf("  Not enough completed moves (%zu)\n", n);
+		return;
+	}
+
+	double sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0;
+	for (const auto &s : samples)
+	{
+		sx += s.first;
+		sy += s.second;
+		sxx += s.first * s.first;
+		sxy += s.first * s.second;
+		syy += s.second * s.second;
+	}
+
+	double denom = n * sxx - sx * sx;
+	if (denom <= 0.0)
+	{
+		printf("  All %zu moves have the same step count, no regression possible\n", n);
+		return;
+	}
+
+	double slope = (n * sxy - sx * sy) / denom; /* ms per step */
+	double intercept = (sy - slope * sx) / n;	/* fixed overhead ms */
+	double ssTot = syy - sy * sy / n;
+	double ssRes = 0;
+	for (const auto &s : samples)
+	{
+		double r = s.second - (intercept + slope * s.first);
+		ssRes += r * r;
+	}
+
+	printf("  Samples:             %zu\n", n);
+	printf("  Fixed overhead:      %.1f ms\n", intercept);
+	printf("  Time per step:       %.4f ms\n", slope);
+	if (slope > 0.0)
+		printf("  Effective step rate: %.0f steps/s\n", 1000.0 / slope);
+	if (ssTot > 0.0)
+		printf("  R^2:                 %.3f\n", 1.0 - ssRes / ssTot);
+}
+
+static void Report(Analysis &a)
+{
+	printf("Trace summary\n");
+	printf("=============\n");
+	printf("  Records: %lld, ports: %zu, span: %.1f s\n", a.records,
+		   a.ports.size() - a.ports.count("-"), a.records ? (a.lastTs - a.firstTs) / 1e6 : 0.0);
+
+	printf("\nRound-trip latency (ms)\n");
+	printf("=======================\n");
+	printf("  %-12s %7s %9s %9s %9s %9s %9s\n", "type", "count", "min", "p50", "p90", "p99", "max");
+	for (auto &entry : a.latencyMs)
+		PrintDistribution(entry.first.c_str(), entry.second);
+
+	printf("\nCommands sent\n");
+	printf("=============\n");
+	for (const auto &entry : a.commandsSent)
+		printf("  %-12s %7lld\n", entry.first.c_str(), entry.second);
+
+	PrintMoveRegression(a.moveSamples);
+
+	printf("\nOvershoot phase gaps (ms)\n");
+	printf("=========================\n");
+	if (a.phaseGapsMs.empty())
+	{
+		printf("  No overshoot moves\n");
+	}
+	else
+	{
+		printf("  %-12s %7s %9s %9s %9s %9s %9s\n", "", "count", "min", "p50", "p90", "p99", "max");
+		PrintDistribution("gap", a.phaseGapsMs);
+	}
+
+	printf("\nTimeouts\n");
+	printf("========\n");
+	long long totalTimeouts = 0;
+	for (const auto &entry : a.timeouts)
+	{
+		printf("  %-24s %7lld\n", entry.first.c_str(), entry.second);
+		totalTimeouts += entry.second;
+	}
+	printf("  Total: %lld, time spent waiting: %.1f s\n", totalTimeouts, a.timeoutWaitMs / 1000.0);
+	if (a.logTimeouts)
+		printf("  From logs: %lld\n", a.logTimeouts);
+
+	printf("\nParse errors\n");
+	printf("============\n");
+	long long totalParse = 0;
+	for (const auto &entry : a.parseErrors)
+	{
+		printf("  %-24s %7lld\n", entry.first.c_str(), entry.second);
+		totalParse += entry.second;
+	}
+	printf("  Total: %lld\n", totalParse);
+	if (a.logParseErrors)
+		printf("  From logs: %lld\n", a.logParseErrors);
+
+	printf("\nLock wait (ms)\n");
+	printf("==============\n");
+	printf("  %-24s %7s %9s %9s %9s %9s\n", "site", "count", "total", "p50", "p99", "max");
+	for (auto &entry : a.lockWaitsMs)
+	{
+		std::vector<double> &v = entry.second;
+		double total = 0.0;
+		for (double w : v)
+			total += w;
+		printf("  %-24s %7zu %9.1f %9.1f %9.1f %9.1f\n", entry.first.c_str(), v.size(), total,
+			   Percentile(v, 50.0), Percentile(v, 99.0), *std::max_element(v.begin(), v.end()));
+	}
+}
+
+static bool AnalyzeStream(Analysis &a, FILE *in, const char *portFilter)
+{
+	char line[512];
+	while (fgets(line, sizeof(line), in))
+	{
+		ParseRecord(a, line, portFilter);
+	}
+	return !ferror(in);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *portFilter = nullptr;
+	std::vector<const char *> files;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+		{
+			portFilter = argv[++i];
+		}
+		else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0)
+		{
+			printf("Usage: %s [-p port] [file ...]\n", argv[0]);
+			printf("Analyze Wanderer Rotator SDK traces (stdin if no files given)\n");
+			return 0;
+		}
+		else
+		{
+			files.push_back(argv[i]);
+		}
+	}
+
+	Analysis analysis;
+
+	if (files.empty())
+	{
+		AnalyzeStream(analysis, stdin, portFilter);
+	}
+
+	for (const char *file : files)
+	{
+		FILE *in = fopen(file, "r");
+		if (!in)
+		{
+			fprintf(stderr, "Cannot open %s\n", file);
+			return 1;
+		}
+		AnalyzeStream(analysis, in, portFilter);
+		fclose(in);
+	}
+
+	Report(analysis);
+	return 0;
+}